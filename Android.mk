@@ -174,6 +174,7 @@ SPVTOOLS_OPT_SRC_FILES := \
 		source/opt/private_to_local_pass.cpp \
 		source/opt/propagator.cpp \
 		source/opt/reduce_load_size.cpp \
+		source/opt/reduce_register_pressure_pass.cpp \
 		source/opt/redundancy_elimination.cpp \
 		source/opt/register_pressure.cpp \
 		source/opt/relax_float_ops_pass.cpp \
@@ -838,6 +838,11 @@ SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPreserveBindings(
 SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPreserveSpecConstants(
     spv_optimizer_options options, bool val);
 
+// Records whether passes that support it should skip functions that have not
+// been modified since the same pass last ran on the module.
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetSkipUnchangedFunctions(
+    spv_optimizer_options options, bool val);
+
 // Creates a reducer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvReducerOptionsDestroy|.
@@ -234,6 +234,13 @@ class SPIRV_TOOLS_EXPORT OptimizerOptions {
                                                 preserve_spec_constants);
   }
 
+  // Records whether passes that support it should skip functions that have
+  // not been modified since the same pass last ran on the module.
+  void set_skip_unchanged_functions(bool skip_unchanged_functions) {
+    spvOptimizerOptionsSetSkipUnchangedFunctions(options_,
+                                                 skip_unchanged_functions);
+  }
+
  private:
   spv_optimizer_options options_;
 };
@@ -15,10 +15,26 @@
 #ifndef INCLUDE_SPIRV_TOOLS_LINTER_HPP_
 #define INCLUDE_SPIRV_TOOLS_LINTER_HPP_
 
+#include <functional>
+#include <string>
+
 #include "libspirv.hpp"
 
 namespace spvtools {
 
+// The outcome of one lint on one module.
+struct LintReport {
+  // The name of the lint, such as "divergent-derivatives".
+  std::string name;
+  // Whether the lint found no errors.
+  bool passed = true;
+  // The wall clock time taken by the lint, in seconds.
+  double wall_time = 0;
+};
+
+// A callback that receives the report of each lint run by a linter.
+using LintReportCallback = std::function<void(const LintReport&)>;
+
 // C++ interface for SPIR-V linting functionalities. It wraps the context
 // (including target environment and the corresponding SPIR-V grammar) and
 // provides a method for linting.
@@ -37,6 +53,10 @@ class SPIRV_TOOLS_EXPORT Linter {
   // Returns a reference to the registered message consumer.
   const MessageConsumer& Consumer() const;
 
+  // Sets a |callback| that receives a LintReport after each lint runs. The
+  // lints are only timed if |callback| is not empty.
+  void SetLintReportCallback(LintReportCallback callback);
+
   bool Run(const uint32_t* binary, size_t binary_size);
 
  private:
@@ -15,6 +15,8 @@
 #ifndef INCLUDE_SPIRV_TOOLS_OPTIMIZER_HPP_
 #define INCLUDE_SPIRV_TOOLS_OPTIMIZER_HPP_
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -32,6 +34,33 @@ class Pass;
 struct DescriptorSetAndBinding;
 }  // namespace opt
 
+// The resource utilization and the effect of one run of an optimization pass.
+// Times are in seconds and the RSS delta is in kilobytes; they are -1 if they
+// could not be measured.
+struct PassReport {
+  // The name of the pass.
+  std::string name;
+  // Whether the pass reported that it changed the module.
+  bool changed = false;
+  // The wall clock and CPU time taken by the pass.
+  double wall_time = -1;
+  double cpu_time = -1;
+  // The growth of the peak resident set size of the process during the pass.
+  int64_t rss_delta = -1;
+  // The number of instructions and words in the module before and after the
+  // pass.  Words include the module header.
+  size_t instructions_before = 0;
+  size_t instructions_after = 0;
+  size_t words_before = 0;
+  size_t words_after = 0;
+  // The names of the analyses that were valid before the pass and were
+  // invalidated by it, such as "DefUse" or "CFG".
+  std::vector<std::string> invalidated_analyses;
+};
+
+// A callback that receives the report of each pass run by an optimizer.
+using PassReportCallback = std::function<void(const PassReport&)>;
+
 // C++ interface for SPIR-V optimization functionalities. It wraps the context
 // (including target environment and the corresponding SPIR-V grammar) and
 // provides methods for registering optimization passes and optimizing.
@@ -94,6 +123,15 @@ class SPIRV_TOOLS_EXPORT Optimizer {
   // method.
   Optimizer& RegisterPass(PassToken&& pass);
 
+  // Registers a group of passes that is run in order, repeatedly, until an
+  // iteration over the group makes no change to the module or
+  // |max_iterations| iterations have run.  Each element of |passes| creates a
+  // new instance of a pass, since a pass instance can only be run once.  A
+  // pass in the group is not run again if no pass has changed the module since
+  // it last ran without making a change.
+  Optimizer& RegisterFixedPointPasses(
+      std::vector<std::function<PassToken()>> passes, uint32_t max_iterations);
+
   // Registers passes that attempt to improve performance of generated code.
   // This sequence of passes is subject to constant review and will change
   // from time to time.
@@ -230,14 +268,39 @@ class SPIRV_TOOLS_EXPORT Optimizer {
   // output is sent to the |out| output stream.
   Optimizer& SetPrintAll(std::ostream* out);
 
+  // Sets the option to print the disassembly before the first pass and then,
+  // after each pass that changed the module, only the global declarations and
+  // functions whose disassembly changed.  If |out| is null, then no output is
+  // generated.  Otherwise, output is sent to the |out| output stream.
+  Optimizer& SetPrintChanged(std::ostream* out);
+
   // Sets the option to print the resource utilization of each pass. If |out|
   // is null, then no output is generated. Otherwise, output is sent to the
   // |out| output stream.
   Optimizer& SetTimeReport(std::ostream* out);
 
+  // Sets a |callback| that receives a PassReport after each pass runs.
+  // Measuring the module before and after each pass costs two walks over the
+  // module, so this is only done if |callback| is not empty.
+  Optimizer& SetPassReportCallback(PassReportCallback callback);
+
+  // Sets the option to print, for each pass, how many times it ran, how many
+  // of those runs changed the module, and how many times it was skipped in a
+  // fixed-point group.  If |out| is null, then no output is generated.
+  // Otherwise, output is sent to the |out| output stream.
+  Optimizer& SetPassStatistics(std::ostream* out);
+
   // Sets the option to validate the module after each pass.
   Optimizer& SetValidateAfterAll(bool validate);
 
+  // Sets the option to skip the validation after each pass that reports that
+  // it did not change the module, once the module has been validated.  This
+  // only has an effect together with SetValidateAfterAll(true).  It makes
+  // validating after each pass much cheaper, but a pass that changes the
+  // module while reporting no change is not caught, and the error is reported
+  // after the next pass that reports a change.
+  Optimizer& SetSkipValidationOfUnchangedModule(bool skip);
+
  private:
   struct SPIRV_TOOLS_LOCAL Impl;  // Opaque struct for holding internal data.
   std::unique_ptr<Impl> impl_;    // Unique pointer to internal data.
@@ -385,6 +448,13 @@ Optimizer::PassToken CreateBlockMergePass();
 // that are not in the call tree of an entry point are not changed.
 Optimizer::PassToken CreateInlineExhaustivePass();
 
+// Creates a budgeted inline pass.
+// Like the exhaustive inline pass, but a function with more than
+// |inline_budget| instructions is only inlined if it has a single call site.
+// This limits code growth when large helper functions are called from many
+// places. An |inline_budget| of 0 is the same as exhaustive inlining.
+Optimizer::PassToken CreateInlineBudgetPass(uint32_t inline_budget);
+
 // Creates an opaque inline pass.
 // An opaque inline pass inlines all function calls in all functions in all
 // entry point call trees where the called function contains an opaque type
@@ -546,10 +616,17 @@ Optimizer::PassToken CreateDeadInsertElimPass();
 // If |remove_outputs| is true, allow outputs to be removed from the interface.
 // This is only safe if the caller knows that there is no corresponding input
 // variable in the following shader. It is false by default.
+//
+// If |incremental| is true, functions that have not been modified since the
+// last incremental run of this pass with the same options are not processed
+// again. It is false by default.
 Optimizer::PassToken CreateAggressiveDCEPass();
 Optimizer::PassToken CreateAggressiveDCEPass(bool preserve_interface);
 Optimizer::PassToken CreateAggressiveDCEPass(bool preserve_interface,
                                              bool remove_outputs);
+Optimizer::PassToken CreateAggressiveDCEPass(bool preserve_interface,
+                                             bool remove_outputs,
+                                             bool incremental);
 
 // Creates a remove-unused-interface-variables pass.
 // Removes variables referenced on the |OpEntryPoint| instruction that are not
@@ -704,6 +781,18 @@ Optimizer::PassToken CreateSimplificationPass();
 // won't be unrolled. See CanPerformUnroll LoopUtils.h for more information.
 Optimizer::PassToken CreateLoopUnrollPass(bool fully_unroll, int factor = 0);
 
+// Creates a loop unroller pass that picks the unroll factor of every loop
+// itself, whether or not the loop has the "Unroll" loop control mask set.
+// Loops with the "DontUnroll" mask are left alone, and so are the loops
+// rejected by LoopUtils::CanPerformUnroll.  A loop is fully unrolled if that
+// fits the limits, and otherwise unrolled by the largest factor up to 8 that
+// divides its trip count and fits them.  The pass adds at most
+// |instruction_budget| instructions to the module, and does not unroll a loop
+// when its estimated register pressure would exceed |max_registers|.  Every
+// decision is reported through the message consumer as an info message.
+Optimizer::PassToken CreateLoopAutoUnrollPass(size_t instruction_budget = 2000,
+                                              size_t max_registers = 64);
+
 // Create the SSA rewrite pass.
 // This pass converts load/store operations on function local variables into
 // operations on SSA IDs.  This allows SSA optimizers to act on these variables.
@@ -747,6 +836,15 @@ Optimizer::PassToken CreateVectorDCEPass();
 Optimizer::PassToken CreateReduceLoadSizePass(
     double load_replacement_threshold = 0.9);
 
+// Create a pass to reduce register pressure.
+// This pass reorders the instructions of each basic block to lower the
+// maximum number of SSA values that are live at the same time, as estimated
+// by the register liveness analysis.  Only instructions without side effects
+// that do not read memory are moved.  The maximum pressure of every function
+// before and after the pass is reported through the message consumer as an
+// info message.
+Optimizer::PassToken CreateReduceRegisterPressurePass();
+
 // Create a pass to combine chained access chains.
 // This pass looks for access chains fed by other access chains and combines
 // them into a single instruction where possible.
@@ -135,6 +135,24 @@ class CFA {
   static std::vector<std::pair<BB*, BB*>> CalculateDominators(
       const std::vector<cbb_ptr>& postorder, get_blocks_func predecessor_func);
 
+  /// @brief Calculates immediate dominators as postorder indices
+  ///
+  /// This is the array based engine behind CalculateDominators.  It is shared
+  /// by the validator and the optimizer, and can be used directly by clients
+  /// that want to keep working with dense indices rather than block pointers.
+  ///
+  /// @param[in] postorder        A vector of blocks in post order traversal
+  ///                             order in a CFG
+  /// @param[in] predecessor_func Function used to get the predecessor nodes of
+  ///                             a block
+  ///
+  /// @return a vector with one entry per block of |postorder|.  Entry i is the
+  /// postorder index of the immediate dominator of postorder[i], the index of
+  /// the root for the root itself, or postorder.size() if the block has no
+  /// dominator.
+  static std::vector<size_t> CalculateDominatorIndices(
+      const std::vector<cbb_ptr>& postorder, get_blocks_func predecessor_func);
+
   // Computes a minimal set of root nodes required to traverse, in the forward
   // direction, the CFG represented by the given vector of blocks, and successor
   // and predecessor functions.  When considering adding two nodes, each having
@@ -217,93 +235,104 @@ void CFA<BB>::DepthFirstTraversal(
 }
 
 template <class BB>
-std::vector<std::pair<BB*, BB*>> CFA<BB>::CalculateDominators(
+std::vector<size_t> CFA<BB>::CalculateDominatorIndices(
     const std::vector<cbb_ptr>& postorder, get_blocks_func predecessor_func) {
-  struct block_detail {
-    size_t dominator;  ///< The index of blocks's dominator in post order array
-    size_t postorder_index;  ///< The index of the block in the post order array
-  };
-  const size_t undefined_dom = postorder.size();
+  const size_t num_blocks = postorder.size();
+  const size_t undefined_dom = num_blocks;
+  std::vector<size_t> dominators(num_blocks, undefined_dom);
+  if (num_blocks == 0) return dominators;
+
+  // Map every block to its postorder index once, so that the fixed point
+  // iteration below works purely on indices.
+  std::unordered_map<cbb_ptr, size_t> postorder_index;
+  postorder_index.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) {
+    postorder_index[postorder[i]] = i;
+  }
 
-  std::unordered_map<cbb_ptr, block_detail> idoms;
-  for (size_t i = 0; i < postorder.size(); i++) {
-    idoms[postorder[i]] = {undefined_dom, i};
+  // Flatten the predecessor lists into a single array.  The predecessors of
+  // the block with postorder index i are
+  // preds[pred_offsets[i]..pred_offsets[i + 1]).  Only predecessors reachable
+  // in the forward traversal are kept; otherwise the intersection doesn't make
+  // sense and will never terminate.
+  std::vector<size_t> pred_offsets;
+  std::vector<size_t> preds;
+  pred_offsets.reserve(num_blocks + 1);
+  preds.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) {
+    pred_offsets.push_back(preds.size());
+    for (const auto* pred : *predecessor_func(postorder[i])) {
+      auto it = postorder_index.find(pred);
+      if (it != postorder_index.end()) preds.push_back(it->second);
+    }
   }
-  idoms[postorder.back()].dominator = idoms[postorder.back()].postorder_index;
+  pred_offsets.push_back(preds.size());
+
+  const size_t root = num_blocks - 1;
+  dominators[root] = root;
 
   bool changed = true;
   while (changed) {
     changed = false;
-    for (auto b = postorder.rbegin() + 1; b != postorder.rend(); ++b) {
-      const std::vector<BB*>& predecessors = *predecessor_func(*b);
-      // Find the first processed/reachable predecessor that is reachable
-      // in the forward traversal.
-      auto res = std::find_if(std::begin(predecessors), std::end(predecessors),
-                              [&idoms, undefined_dom](BB* pred) {
-                                return idoms.count(pred) &&
-                                       idoms[pred].dominator != undefined_dom;
-                              });
-      if (res == end(predecessors)) continue;
-      const BB* idom = *res;
-      size_t idom_idx = idoms[idom].postorder_index;
+    for (size_t b = root; b-- > 0;) {
+      const size_t* first = preds.data() + pred_offsets[b];
+      const size_t* last = preds.data() + pred_offsets[b + 1];
+      // Find the first processed predecessor.
+      const size_t* res =
+          std::find_if(first, last, [&dominators, undefined_dom](size_t pred) {
+            return dominators[pred] != undefined_dom;
+          });
+      if (res == last) continue;
+      const size_t idom = *res;
+      size_t idom_idx = idom;
 
       // all other predecessors
-      for (const auto* p : predecessors) {
-        if (idom == p) continue;
-        // Only consider nodes reachable in the forward traversal.
-        // Otherwise the intersection doesn't make sense and will never
-        // terminate.
-        if (!idoms.count(p)) continue;
-        if (idoms[p].dominator != undefined_dom) {
-          size_t finger1 = idoms[p].postorder_index;
-          size_t finger2 = idom_idx;
-          while (finger1 != finger2) {
-            while (finger1 < finger2) {
-              finger1 = idoms[postorder[finger1]].dominator;
-            }
-            while (finger2 < finger1) {
-              finger2 = idoms[postorder[finger2]].dominator;
-            }
+      for (const size_t* p = first; p != last; ++p) {
+        if (*p == idom || dominators[*p] == undefined_dom) continue;
+        size_t finger1 = *p;
+        size_t finger2 = idom_idx;
+        while (finger1 != finger2) {
+          while (finger1 < finger2) {
+            finger1 = dominators[finger1];
+          }
+          while (finger2 < finger1) {
+            finger2 = dominators[finger2];
           }
-          idom_idx = finger1;
         }
+        idom_idx = finger1;
       }
-      if (idoms[*b].dominator != idom_idx) {
-        idoms[*b].dominator = idom_idx;
+      if (dominators[b] != idom_idx) {
+        dominators[b] = idom_idx;
         changed = true;
       }
     }
   }
 
+  return dominators;
+}
+
+template <class BB>
+std::vector<std::pair<BB*, BB*>> CFA<BB>::CalculateDominators(
+    const std::vector<cbb_ptr>& postorder, get_blocks_func predecessor_func) {
+  const std::vector<size_t> dominators =
+      CalculateDominatorIndices(postorder, predecessor_func);
+
+  // Emitting the edges in postorder index order generates a deterministic
+  // ordering of edges without having to sort them.
   std::vector<std::pair<bb_ptr, bb_ptr>> out;
-  for (auto idom : idoms) {
+  out.reserve(postorder.size());
+  for (size_t i = 0; i < postorder.size(); i++) {
     // At this point if there is no dominator for the node, just make it
     // reflexive.
-    auto dominator = std::get<1>(idom).dominator;
-    if (dominator == undefined_dom) {
-      dominator = std::get<1>(idom).postorder_index;
+    size_t dominator = dominators[i];
+    if (dominator == postorder.size()) {
+      dominator = i;
     }
     // NOTE: performing a const cast for convenient usage with
     // UpdateImmediateDominators
-    out.push_back({const_cast<BB*>(std::get<0>(idom)),
+    out.push_back({const_cast<BB*>(postorder[i]),
                    const_cast<BB*>(postorder[dominator])});
   }
-
-  // Sort by postorder index to generate a deterministic ordering of edges.
-  std::sort(
-      out.begin(), out.end(),
-      [&idoms](const std::pair<bb_ptr, bb_ptr>& lhs,
-               const std::pair<bb_ptr, bb_ptr>& rhs) {
-        assert(lhs.first);
-        assert(lhs.second);
-        assert(rhs.first);
-        assert(rhs.second);
-        auto lhs_indices = std::make_pair(idoms[lhs.first].postorder_index,
-                                          idoms[lhs.second].postorder_index);
-        auto rhs_indices = std::make_pair(idoms[rhs.first].postorder_index,
-                                          idoms[rhs.second].postorder_index);
-        return lhs_indices < rhs_indices;
-      });
   return out;
 }
 
@@ -75,7 +75,9 @@ DiagnosticStream::DiagnosticStream(DiagnosticStream&& other)
       position_(other.position_),
       consumer_(other.consumer_),
       disassembled_instruction_(std::move(other.disassembled_instruction_)),
-      error_(other.error_) {
+      error_(other.error_),
+      shader_debug_info_(std::move(other.shader_debug_info_)),
+      render_context_(std::move(other.render_context_)) {
   // Prevent the other object from emitting output during destruction.
   other.error_ = SPV_FAILED_MATCH;
   // Some platforms are missing support for std::ostringstream functionality,
@@ -106,6 +108,9 @@ DiagnosticStream::~DiagnosticStream() {
       default:
         break;
     }
+    if (render_context_) {
+      render_context_(&disassembled_instruction_, &shader_debug_info_);
+    }
     if (!disassembled_instruction_.empty())
       stream_ << std::endl << "  " << disassembled_instruction_ << std::endl;
 
@@ -15,6 +15,7 @@
 #ifndef SOURCE_DIAGNOSTIC_H_
 #define SOURCE_DIAGNOSTIC_H_
 
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -28,6 +29,11 @@ namespace spvtools {
 // emitted during the destructor.
 class DiagnosticStream {
  public:
+  // Computes the disassembled instruction and the shader debug info that are
+  // appended to a message.
+  using ContextRenderer = std::function<void(
+      std::string* disassembled_instruction, std::string* shader_debug_info)>;
+
   DiagnosticStream(spv_position_t position, const MessageConsumer& consumer,
                    const std::string& disassembled_instruction,
                    spv_result_t error, std::string shader_debug_info = "")
@@ -37,6 +43,17 @@ class DiagnosticStream {
         error_(error),
         shader_debug_info_(shader_debug_info) {}
 
+  // Same as above, except that the disassembled instruction and the shader
+  // debug info are computed by |render_context| when the message is emitted.
+  // They are never computed if the message is not emitted, for example
+  // because there is no consumer.
+  DiagnosticStream(spv_position_t position, const MessageConsumer& consumer,
+                   ContextRenderer render_context, spv_result_t error)
+      : position_(position),
+        consumer_(consumer),
+        error_(error),
+        render_context_(std::move(render_context)) {}
+
   // Creates a DiagnosticStream from an expiring DiagnosticStream.
   // The new object takes the contents of the other, and prevents the
   // other from emitting anything during destruction.
@@ -65,6 +82,9 @@ class DiagnosticStream {
   spv_result_t error_;
   // Provide way to pass optional information from ShaderDebugInfo
   std::string shader_debug_info_;
+  // If set, computes |disassembled_instruction_| and |shader_debug_info_|
+  // when the message is emitted.
+  ContextRenderer render_context_;
 };
 
 // Changes the MessageConsumer in |context| to one that updates |diagnostic|
@@ -17,9 +17,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "source/util/make_unique.h"
@@ -34,20 +34,26 @@ namespace fuzz {
 // of type |T|.
 //
 // A disjoint-set (a.k.a. union-find or merge-find) data structure is used to
-// represent the equivalence relation.  Path compression is used.  Union by
-// rank/size is not used.
+// represent the equivalence relation.  Union by rank and path compression are
+// both used, so that 'Find' runs in amortized near-constant time.
 //
-// Each disjoint set is represented as a tree, rooted at the representative
-// of the set.
-//
-// Getting the representative of a value simply requires chasing parent pointers
-// from the value until you reach the root.
+// Each unique (up to equality) value added to the relation is copied into
+// |owned_values_| and assigned a dense index, its position in that vector.
+// All other per-value state is stored in vectors indexed by this dense index,
+// so that no hashing is needed once a value's index is known.  The index of a
+// value is found via |value_to_index_|, which uses |PointerHashT| and
+// |PointerEqualsT|.
 //
-// Checking equivalence of two elements requires checking that the
-// representatives are equal.
+// Each disjoint set is represented as a tree, rooted at the representative
+// of the set, via |parent_|.  Checking equivalence of two elements requires
+// checking that the representatives are equal.
 //
-// Traversing the tree rooted at a value's representative visits the value's
-// equivalence class.
+// In addition, the members of each equivalence class are linked into a
+// circular list via |next_in_class_|.  Merging two classes splices their lists
+// in constant time, and enumerating a class walks its list, in time
+// proportional to the size of the class.  The representatives are linked into
+// a doubly-linked list, in the order in which they were registered, so that
+// they can be enumerated in time proportional to the number of classes.
 //
 // |PointerHashT| and |PointerEqualsT| are used to define *equality* between
 // values, and otherwise are *not* used to define the equivalence relation
@@ -60,13 +66,6 @@ namespace fuzz {
 // IDs in a SPIR-V binary that are known to contain the same value at run time,
 // but clearly 1 != 5.  Since 1 and 1 are equal, IsEquivalent(1, 1) will also
 // hold.
-//
-// Each unique (up to equality) value added to the relation is copied into
-// |owned_values_|, so there is one canonical memory address per unique value.
-// Uniqueness is ensured by storing (and checking) a set of pointers to these
-// values in |value_set_|, which uses |PointerHashT| and |PointerEqualsT|.
-//
-// |parent_| and |children_| encode the equivalence relation, i.e., the trees.
 template <typename T, typename PointerHashT, typename PointerEqualsT>
 class EquivalenceRelation {
  public:
@@ -79,26 +78,31 @@ class EquivalenceRelation {
     assert(Exists(value2) &&
            "Precondition: value2 must already be registered.");
 
-    // Look up canonical pointers to each of the values in the value pool.
-    const T* value1_ptr = *value_set_.find(&value1);
-    const T* value2_ptr = *value_set_.find(&value2);
-
-    // If the values turn out to be identical, they are already in the same
-    // equivalence class so there is nothing to do.
-    if (value1_ptr == value2_ptr) {
+    // Find the representative for each value's equivalence class.  If the
+    // values are identical, or are already in the same class, there is nothing
+    // to do.
+    uint32_t representative1 = FindIndex(GetIndex(value1));
+    uint32_t representative2 = FindIndex(GetIndex(value2));
+    if (representative1 == representative2) {
       return;
     }
 
-    // Find the representative for each value's equivalence class, and if they
-    // are not already in the same class, make one the parent of the other.
-    const T* representative1 = Find(value1_ptr);
-    const T* representative2 = Find(value2_ptr);
-    assert(representative1 && "Representatives should never be null.");
-    assert(representative2 && "Representatives should never be null.");
-    if (representative1 != representative2) {
-      parent_[representative1] = representative2;
-      children_[representative2].push_back(representative1);
+    // Make the representative of lower rank a child of the other one, so that
+    // the trees stay shallow.
+    if (rank_[representative1] > rank_[representative2]) {
+      std::swap(representative1, representative2);
+    }
+    parent_[representative1] = representative2;
+    if (rank_[representative1] == rank_[representative2]) {
+      ++rank_[representative2];
     }
+
+    // Splice the circular lists of the two classes together.
+    std::swap(next_in_class_[representative1],
+              next_in_class_[representative2]);
+
+    // |representative1| no longer represents a class.
+    UnlinkRepresentative(representative1);
   }
 
   // Requires that |value| is not known to the equivalence relation. Registers
@@ -108,16 +112,26 @@ class EquivalenceRelation {
     assert(!Exists(value));
 
     // This relies on T having a copy constructor.
-    auto unique_pointer_to_value = MakeUnique<T>(value);
-    auto pointer_to_value = unique_pointer_to_value.get();
-    owned_values_.push_back(std::move(unique_pointer_to_value));
-    value_set_.insert(pointer_to_value);
+    const auto index = static_cast<uint32_t>(owned_values_.size());
+    owned_values_.push_back(MakeUnique<T>(value));
+    const T* pointer_to_value = owned_values_.back().get();
+    value_to_index_.insert({pointer_to_value, index});
 
-    // Initially say that the value is its own parent and that it has no
-    // children.
-    assert(pointer_to_value && "Representatives should never be null.");
-    parent_[pointer_to_value] = pointer_to_value;
-    children_[pointer_to_value] = std::vector<const T*>();
+    // Initially say that the value is its own parent, and the only member of
+    // its equivalence class.
+    parent_.push_back(index);
+    rank_.push_back(0);
+    next_in_class_.push_back(index);
+
+    // Append the new class to the list of representatives.
+    previous_representative_.push_back(last_representative_);
+    next_representative_.push_back(kNoIndex);
+    if (last_representative_ == kNoIndex) {
+      first_representative_ = index;
+    } else {
+      next_representative_[last_representative_] = index;
+    }
+    last_representative_ = index;
 
     return pointer_to_value;
   }
@@ -125,34 +139,26 @@ class EquivalenceRelation {
   // Returns exactly one representative per equivalence class.
   std::vector<const T*> GetEquivalenceClassRepresentatives() const {
     std::vector<const T*> result;
-    for (auto& value : owned_values_) {
-      if (parent_[value.get()] == value.get()) {
-        result.push_back(value.get());
-      }
+    for (uint32_t index = first_representative_; index != kNoIndex;
+         index = next_representative_[index]) {
+      result.push_back(owned_values_[index].get());
     }
     return result;
   }
 
   // Returns pointers to all values in the equivalence class of |value|, which
-  // must already be part of the equivalence relation.
+  // must already be part of the equivalence relation.  The representative of
+  // the class comes first.
   std::vector<const T*> GetEquivalenceClass(const T& value) const {
     assert(Exists(value));
 
     std::vector<const T*> result;
-
-    // Traverse the tree of values rooted at the representative of the
-    // equivalence class to which |value| belongs, and collect up all the values
-    // that are encountered.  This constitutes the whole equivalence class.
-    std::vector<const T*> stack;
-    stack.push_back(Find(*value_set_.find(&value)));
-    while (!stack.empty()) {
-      const T* item = stack.back();
-      result.push_back(item);
-      stack.pop_back();
-      for (auto child : children_[item]) {
-        stack.push_back(child);
-      }
-    }
+    const uint32_t representative = FindIndex(GetIndex(value));
+    uint32_t index = representative;
+    do {
+      result.push_back(owned_values_[index].get());
+      index = next_in_class_[index];
+    } while (index != representative);
     return result;
   }
 
@@ -160,12 +166,13 @@ class EquivalenceRelation {
   // equivalence class.  Both values must already be known to the equivalence
   // relation.
   bool IsEquivalent(const T& value1, const T& value2) const {
-    return Find(&value1) == Find(&value2);
+    return FindIndex(GetIndex(value1)) == FindIndex(GetIndex(value2));
   }
 
   // Returns all values known to be part of the equivalence relation.
   std::vector<const T*> GetAllKnownValues() const {
     std::vector<const T*> result;
+    result.reserve(owned_values_.size());
     for (auto& value : owned_values_) {
       result.push_back(value.get());
     }
@@ -175,7 +182,7 @@ class EquivalenceRelation {
   // Returns true if and only if |value| is known to be part of the equivalence
   // relation.
   bool Exists(const T& value) const {
-    return value_set_.find(&value) != value_set_.end();
+    return value_to_index_.find(&value) != value_to_index_.end();
   }
 
   // Returns the representative of the equivalence class of |value|, which must
@@ -183,62 +190,90 @@ class EquivalenceRelation {
   // in a classic union-find data structure.
   const T* Find(const T* value) const {
     assert(Exists(*value));
+    return owned_values_[FindIndex(GetIndex(*value))].get();
+  }
 
-    // Get the canonical pointer to the value from the value pool.
-    const T* known_value = *value_set_.find(value);
-    assert(parent_[known_value] && "Every known value should have a parent.");
+ private:
+  // Used to mark the absence of a value in the representative list.
+  static constexpr uint32_t kNoIndex = 0xFFFFFFFF;
+
+  // Returns the dense index of |value|, which must be known to the
+  // equivalence relation.
+  uint32_t GetIndex(const T& value) const {
+    auto it = value_to_index_.find(&value);
+    assert(it != value_to_index_.end() && "The value must be registered.");
+    return it->second;
+  }
 
-    // Compute the result by chasing parents until we find a value that is its
-    // own parent.
-    const T* result = known_value;
+  // Returns the index of the representative of the class containing the value
+  // with index |index|, compressing the path from that value to the root so
+  // that every value on it points directly to the representative.
+  uint32_t FindIndex(uint32_t index) const {
+    uint32_t result = index;
     while (parent_[result] != result) {
       result = parent_[result];
     }
-    assert(result && "Representatives should never be null.");
-
-    // At this point, |result| is the representative of the equivalence class.
-    // Now perform the 'path compression' optimization by doing another pass up
-    // the parent chain, setting the parent of each node to be the
-    // representative, and rewriting children correspondingly.
-    const T* current = known_value;
-    while (parent_[current] != result) {
-      const T* next = parent_[current];
-      parent_[current] = result;
-      children_[result].push_back(current);
-      auto child_iterator =
-          std::find(children_[next].begin(), children_[next].end(), current);
-      assert(child_iterator != children_[next].end() &&
-             "'next' is the parent of 'current', so 'current' should be a "
-             "child of 'next'");
-      children_[next].erase(child_iterator);
-      current = next;
+    while (parent_[index] != result) {
+      const uint32_t next = parent_[index];
+      parent_[index] = result;
+      index = next;
     }
     return result;
   }
 
- private:
+  // Removes |index|, which must be a former representative, from the list of
+  // representatives.
+  void UnlinkRepresentative(uint32_t index) {
+    const uint32_t previous = previous_representative_[index];
+    const uint32_t next = next_representative_[index];
+    if (previous == kNoIndex) {
+      first_representative_ = next;
+    } else {
+      next_representative_[previous] = next;
+    }
+    if (next == kNoIndex) {
+      last_representative_ = previous;
+    } else {
+      previous_representative_[next] = previous;
+    }
+    previous_representative_[index] = kNoIndex;
+    next_representative_[index] = kNoIndex;
+  }
+
+  // The values known to the equivalence relation, indexed by their dense
+  // index.
+  std::vector<std::unique_ptr<T>> owned_values_;
+
+  // Provides (via |PointerHashT| and |PointerEqualsT|) a means for mapping a
+  // value of interest to the dense index of an equal value in
+  // |owned_values_|.
+  std::unordered_map<const T*, uint32_t, PointerHashT, PointerEqualsT>
+      value_to_index_;
+
   // Maps every value to a parent.  The representative of an equivalence class
   // is its own parent.  A value's representative can be found by walking its
   // chain of ancestors.
   //
   // Mutable because the intuitively const method, 'Find', performs path
   // compression.
-  mutable std::unordered_map<const T*, const T*> parent_;
+  mutable std::vector<uint32_t> parent_;
 
-  // Stores the children of each value.  This allows the equivalence class of
-  // a value to be calculated by traversing all descendents of the class's
-  // representative.
-  //
-  // Mutable because the intuitively const method, 'Find', performs path
-  // compression.
-  mutable std::unordered_map<const T*, std::vector<const T*>> children_;
+  // An upper bound on the height of the tree rooted at each representative.
+  // Only meaningful for representatives.
+  std::vector<uint32_t> rank_;
 
-  // The values known to the equivalence relation are allocated in
-  // |owned_values_|, and |value_pool_| provides (via |PointerHashT| and
-  // |PointerEqualsT|) a means for mapping a value of interest to a pointer
-  // into an equivalent value in |owned_values_|.
-  std::unordered_set<const T*, PointerHashT, PointerEqualsT> value_set_;
-  std::vector<std::unique_ptr<T>> owned_values_;
+  // Links the members of each equivalence class into a circular list.
+  std::vector<uint32_t> next_in_class_;
+
+  // Link the representatives into a doubly-linked list, in registration
+  // order.  Both are |kNoIndex| for values that are not representatives.
+  std::vector<uint32_t> previous_representative_;
+  std::vector<uint32_t> next_representative_;
+
+  // The first and last representatives in the list, or |kNoIndex| if the
+  // relation is empty.
+  uint32_t first_representative_ = kNoIndex;
+  uint32_t last_representative_ = kNoIndex;
 };
 
 }  // namespace fuzz
@@ -209,6 +209,16 @@ DivergenceAnalysis::ComputeVariableDivergence(opt::Instruction* var) {
 }
 
 void DivergenceAnalysis::Setup(opt::Function* function) {
+  // The module is not modified by the lints, so the state is sized once. The
+  // bound is computed from the instructions, as the header of an unvalidated
+  // module cannot be trusted.
+  if (divergence_.empty()) {
+    const uint32_t id_bound = context().module()->ComputeIdBound();
+    divergence_.resize(id_bound, DivergenceLevel::kUniform);
+    divergence_source_.resize(id_bound, 0);
+    divergence_dependence_source_.resize(id_bound, 0);
+    follow_unconditional_branches_.resize(id_bound, 0);
+  }
   // TODO(kuhar): Run functions called by |function| so we can detect
   // reconvergence caused by multiple returns.
   cd_.ComputeControlDependenceGraph(
@@ -17,7 +17,7 @@
 
 #include <cstdint>
 #include <ostream>
-#include <unordered_map>
+#include <vector>
 
 #include "source/opt/basic_block.h"
 #include "source/opt/control_dependence.h"
@@ -74,12 +74,9 @@ class DivergenceAnalysis : public opt::ForwardDataFlowAnalysis {
 
   // Returns the divergence level for the given value (non-label instructions),
   // or control flow for the given block.
-  DivergenceLevel GetDivergenceLevel(uint32_t id) {
-    auto it = divergence_.find(id);
-    if (it == divergence_.end()) {
-      return DivergenceLevel::kUniform;
-    }
-    return it->second;
+  DivergenceLevel GetDivergenceLevel(uint32_t id) const {
+    return id < divergence_.size() ? divergence_[id]
+                                   : DivergenceLevel::kUniform;
   }
 
   // Returns the divergence source for the given id. The following types of
@@ -89,12 +86,8 @@ class DivergenceAnalysis : public opt::ForwardDataFlowAnalysis {
   // data -> control: B is control-dependent on a branch with condition A.
   // control -> data: B is a OpPhi instruction in which A is a block operand.
   // control -> control: B is control-dependent on A.
-  uint32_t GetDivergenceSource(uint32_t id) {
-    auto it = divergence_source_.find(id);
-    if (it == divergence_source_.end()) {
-      return 0;
-    }
-    return it->second;
+  uint32_t GetDivergenceSource(uint32_t id) const {
+    return id < divergence_source_.size() ? divergence_source_[id] : 0;
   }
 
   // Returns the dependence source for the control dependence for the given id.
@@ -106,12 +99,10 @@ class DivergenceAnalysis : public opt::ForwardDataFlowAnalysis {
   // * GetDivergenceDependenceSource(2) = 1
   //
   // Returns 0 if not applicable.
-  uint32_t GetDivergenceDependenceSource(uint32_t id) {
-    auto it = divergence_dependence_source_.find(id);
-    if (it == divergence_dependence_source_.end()) {
-      return 0;
-    }
-    return it->second;
+  uint32_t GetDivergenceDependenceSource(uint32_t id) const {
+    return id < divergence_dependence_source_.size()
+               ? divergence_dependence_source_[id]
+               : 0;
   }
 
   void InitializeWorklist(opt::Function* function,
@@ -142,14 +133,17 @@ class DivergenceAnalysis : public opt::ForwardDataFlowAnalysis {
   // Initializes data structures for performing dataflow on the given function.
   void Setup(opt::Function* function);
 
-  std::unordered_map<uint32_t, DivergenceLevel> divergence_;
-  std::unordered_map<uint32_t, uint32_t> divergence_source_;
-  std::unordered_map<uint32_t, uint32_t> divergence_dependence_source_;
+  // The state of the analysis, indexed by id. They are sized to the id bound
+  // of the module by |Setup|, and keep the results of the functions analyzed
+  // earlier.
+  std::vector<DivergenceLevel> divergence_;
+  std::vector<uint32_t> divergence_source_;
+  std::vector<uint32_t> divergence_dependence_source_;
 
   // Stores the result of following unconditional branches starting from the
-  // given block. This is used to detect when reconvergence needs to be
-  // accounted for.
-  std::unordered_map<uint32_t, uint32_t> follow_unconditional_branches_;
+  // given block, indexed by block id. This is used to detect when
+  // reconvergence needs to be accounted for.
+  std::vector<uint32_t> follow_unconditional_branches_;
 
   opt::ControlDependenceAnalysis cd_;
 };
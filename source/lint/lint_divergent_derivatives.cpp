@@ -91,8 +91,8 @@ spvtools::DiagnosticStream Warn(opt::IRContext* context,
   }
 }
 
-void PrintDivergenceFlow(opt::IRContext* context, DivergenceAnalysis div,
-                         uint32_t id) {
+void PrintDivergenceFlow(opt::IRContext* context,
+                         const DivergenceAnalysis& div, uint32_t id) {
   opt::analysis::DefUseManager* def_use = context->get_def_use_mgr();
   opt::CFG* cfg = context->cfg();
   while (id != 0) {
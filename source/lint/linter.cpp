@@ -14,6 +14,8 @@
 
 #include "spirv-tools/linter.hpp"
 
+#include <chrono>
+
 #include "source/lint/lints.h"
 #include "source/opt/build_module.h"
 #include "source/opt/ir_context.h"
@@ -21,6 +23,20 @@
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
+namespace {
+
+// A lint and the name it is reported under.
+struct LintEntry {
+  const char* name;
+  bool (*check)(opt::IRContext* context);
+};
+
+// The lints run by |Linter::Run|, in order.
+const LintEntry kLints[] = {
+    {"divergent-derivatives", lint::lints::CheckDivergentDerivatives},
+};
+
+}  // namespace
 
 struct Linter::Impl {
   explicit Impl(spv_target_env env) : target_env(env) {
@@ -29,8 +45,9 @@ struct Linter::Impl {
                           const char* /*message*/) {};
   }
 
-  spv_target_env target_env;         // Target environment.
-  MessageConsumer message_consumer;  // Message consumer.
+  spv_target_env target_env;           // Target environment.
+  MessageConsumer message_consumer;    // Message consumer.
+  LintReportCallback report_callback;  // Receives the report of each lint.
 };
 
 Linter::Linter(spv_target_env env) : impl_(new Impl(env)) {}
@@ -41,6 +58,10 @@ void Linter::SetMessageConsumer(MessageConsumer consumer) {
   impl_->message_consumer = std::move(consumer);
 }
 
+void Linter::SetLintReportCallback(LintReportCallback callback) {
+  impl_->report_callback = std::move(callback);
+}
+
 const MessageConsumer& Linter::Consumer() const {
   return impl_->message_consumer;
 }
@@ -51,7 +72,22 @@ bool Linter::Run(const uint32_t* binary, size_t binary_size) {
   if (context == nullptr) return false;
 
   bool result = true;
-  result &= lint::lints::CheckDivergentDerivatives(context.get());
+  for (const LintEntry& lint : kLints) {
+    if (!impl_->report_callback) {
+      result &= lint.check(context.get());
+      continue;
+    }
+
+    LintReport report;
+    report.name = lint.name;
+    const auto start = std::chrono::steady_clock::now();
+    report.passed = lint.check(context.get());
+    report.wall_time = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    result &= report.passed;
+    impl_->report_callback(report);
+  }
 
   return result;
 }
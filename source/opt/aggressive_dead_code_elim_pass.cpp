@@ -201,11 +201,11 @@ void AggressiveDCEPass::ProcessLoad(Function* func, uint32_t varId) {
   // Only process locals
   if (!IsLocalVar(varId, func)) return;
   // Return if already processed
-  if (live_local_vars_.find(varId) != live_local_vars_.end()) return;
+  if (live_local_vars_.Get(varId)) return;
   // Mark all stores to varId as live
   AddStores(func, varId);
   // Cache varId as processed
-  live_local_vars_.insert(varId);
+  live_local_vars_.Set(varId);
 }
 
 void AggressiveDCEPass::AddBranch(uint32_t labelId, BasicBlock* bp) {
@@ -279,7 +279,7 @@ Pass::Status AggressiveDCEPass::AggressiveDCE(Function* func) {
   if (func->IsDeclaration()) return Pass::Status::SuccessWithoutChange;
   std::list<BasicBlock*> structured_order;
   cfg()->ComputeStructuredOrder(func, &*func->begin(), &structured_order);
-  live_local_vars_.clear();
+  live_local_vars_.ClearAll();
   InitializeWorkList(func, structured_order);
   ProcessWorkList(func);
   if (ProcessDebugInformation(structured_order) == Pass::Status::Failure)
@@ -422,15 +422,38 @@ Pass::Status AggressiveDCEPass::KillDeadInstructions(
 }
 
 void AggressiveDCEPass::ProcessWorkList(Function* func) {
-  while (!worklist_.empty()) {
-    Instruction* live_inst = worklist_.front();
-    worklist_.pop();
+  // |worklist_| may grow while it is being processed, so it must be indexed
+  // rather than iterated.
+  while (worklist_head_ < worklist_.size()) {
+    Instruction* live_inst = worklist_[worklist_head_++];
     AddOperandsToWorkList(live_inst);
     MarkBlockAsLive(live_inst);
     MarkLoadedVariablesAsLive(func, live_inst);
     AddDecorationsToWorkList(live_inst);
     AddDebugInstructionsToWorkList(live_inst);
   }
+  worklist_.clear();
+  worklist_head_ = 0;
+}
+
+void AggressiveDCEPass::MarkAllInstructionsAsLive(Function* func) {
+  // Mark the whole function first so that only module-scope definitions are
+  // added to the work list below.
+  func->ForEachInst(
+      [this](Instruction* inst) { live_insts_.Set(inst->unique_id()); });
+  func->ForEachInst([this](Instruction* inst) {
+    AddOperandsToWorkList(inst);
+    AddDecorationsToWorkList(inst);
+    AddDebugInstructionsToWorkList(inst);
+  });
+  ProcessWorkList(func);
+}
+
+std::string AggressiveDCEPass::GetEpochKey() const {
+  std::string key = name();
+  if (preserve_interface_) key += ",preserve-interface";
+  if (remove_outputs_) key += ",remove-outputs";
+  return key;
 }
 
 void AggressiveDCEPass::AddDebugScopeToWorkList(const Instruction* inst) {
@@ -810,12 +833,21 @@ Pass::Status AggressiveDCEPass::ProcessImpl() {
   // will become dead if all function call to them are removed.  These dead
   // function will still be in the module after this pass.  We expect this to be
   // rare.
+  std::vector<Function*> changed_functions;
   for (Function& fp : *context()->module()) {
+    // In incremental mode, functions that have not changed since the last run
+    // were already cleaned up by that run.
+    if (IsFunctionUnchanged(&fp)) {
+      MarkAllInstructionsAsLive(&fp);
+      continue;
+    }
+    changed_functions.push_back(&fp);
     Pass::Status function_status = AggressiveDCE(&fp);
     if (function_status == Pass::Status::Failure) {
       return Pass::Status::Failure;
     }
     if (function_status == Pass::Status::SuccessWithChange) {
+      context()->MarkFunctionModified(&fp);
       modified = true;
     }
   }
@@ -839,15 +871,16 @@ Pass::Status AggressiveDCEPass::ProcessImpl() {
          "A dead instruction was identified, but no change recorded.");
 
   // Kill all dead instructions.
-  for (auto inst : to_kill_) {
-    context()->KillInst(inst);
-  }
+  context()->KillInstructions(to_kill_);
 
   // Cleanup all CFG including all unreachable blocks.
-  for (Function& fp : *context()->module()) {
-    auto status = CFGCleanup(&fp);
+  for (Function* fp : changed_functions) {
+    auto status = CFGCleanup(fp);
     if (status == Status::Failure) return Status::Failure;
-    if (status == Status::SuccessWithChange) modified = true;
+    if (status == Status::SuccessWithChange) {
+      context()->MarkFunctionModified(fp);
+      modified = true;
+    }
   }
 
   return modified ? Status::SuccessWithChange : Status::SuccessWithoutChange;
@@ -20,7 +20,6 @@
 #include <algorithm>
 #include <list>
 #include <map>
-#include <queue>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -45,13 +44,19 @@ class AggressiveDCEPass : public MemPass {
       std::function<std::vector<BasicBlock*>*(const BasicBlock*)>;
 
   AggressiveDCEPass(bool preserve_interface = false,
-                    bool remove_outputs = false)
+                    bool remove_outputs = false, bool incremental = false)
       : preserve_interface_(preserve_interface),
-        remove_outputs_(remove_outputs) {}
+        remove_outputs_(remove_outputs) {
+    SetIncremental(incremental);
+  }
 
   const char* name() const override { return "eliminate-dead-code-aggressive"; }
   Status Process() override;
 
+  bool ReportsModifiedFunctions() const override { return true; }
+  bool SupportsIncrementalProcessing() const override { return true; }
+  std::string GetEpochKey() const override;
+
   IRContext::Analysis GetPreservedAnalyses() override {
     return IRContext::kAnalysisDefUse |
            IRContext::kAnalysisInstrToBlockMapping |
@@ -93,10 +98,15 @@ class AggressiveDCEPass : public MemPass {
   // Add |inst| to worklist_ and live_insts_.
   void AddToWorklist(Instruction* inst) {
     if (!live_insts_.Set(inst->unique_id())) {
-      worklist_.push(inst);
+      worklist_.push_back(inst);
     }
   }
 
+  // Marks every instruction in |func| as live, and adds the module-scope
+  // instructions they depend on to the live set.  Used for functions that
+  // are known to contain no dead code.
+  void MarkAllInstructionsAsLive(Function* func);
+
   // Add all store instruction which use |ptrId|, directly or indirectly,
   // to the live instruction worklist.
   void AddStores(Function* func, uint32_t ptrId);
@@ -255,15 +265,20 @@ class AggressiveDCEPass : public MemPass {
   // Live Instruction Worklist.  An instruction is added to this list
   // if it might have a side effect, either directly or indirectly.
   // If we don't know, then add it to this list.  Instructions are
-  // removed from this list as the algorithm traces side effects,
-  // building up the live instructions set |live_insts_|.
-  std::queue<Instruction*> worklist_;
+  // processed in FIFO order starting at |worklist_head_| as the algorithm
+  // traces side effects, building up the live instructions set |live_insts_|.
+  // The list is cleared, but not deallocated, once it has been processed, so
+  // its storage is reused for every function.
+  std::vector<Instruction*> worklist_;
+
+  // Index of the next instruction to process in |worklist_|.
+  size_t worklist_head_ = 0;
 
-  // Live Instructions
+  // Live Instructions, indexed by unique id.
   utils::BitVector live_insts_;
 
-  // Live Local Variables
-  std::unordered_set<uint32_t> live_local_vars_;
+  // Live Local Variables, indexed by result id.
+  utils::BitVector live_local_vars_;
 
   // List of instructions to delete. Deletion is delayed until debug and
   // annotation instructions are processed.
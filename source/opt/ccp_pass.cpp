@@ -21,10 +21,13 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "source/opt/fold.h"
 #include "source/opt/function.h"
 #include "source/opt/propagator.h"
+#include "source/util/make_unique.h"
 
 namespace spvtools {
 namespace opt {
@@ -40,7 +43,7 @@ bool CCPPass::IsVaryingValue(uint32_t id) const { return id == kVaryingSSAId; }
 SSAPropagator::PropStatus CCPPass::MarkInstructionVarying(Instruction* instr) {
   assert(instr->result_id() != 0 &&
          "Instructions with no result cannot be marked varying.");
-  values_[instr->result_id()] = kVaryingSSAId;
+  SetValue(instr->result_id(), kVaryingSSAId);
   return SSAPropagator::kVarying;
 }
 
@@ -56,19 +59,19 @@ SSAPropagator::PropStatus CCPPass::VisitPhi(Instruction* phi) {
       continue;
     }
     uint32_t phi_arg_id = phi->GetSingleWordOperand(i);
-    auto it = values_.find(phi_arg_id);
-    if (it != values_.end()) {
+    const uint32_t arg_val = GetValue(phi_arg_id);
+    if (arg_val != kNoValue) {
       // We found an argument with a constant value.  Apply the meet operation
       // with the previous arguments.
-      if (it->second == kVaryingSSAId) {
+      if (arg_val == kVaryingSSAId) {
         // The "constant" value is actually a placeholder for varying. Return
         // varying for this phi.
         return MarkInstructionVarying(phi);
       } else if (meet_val_id == 0) {
         // This is the first argument we find.  Initialize the result to its
         // constant value id.
-        meet_val_id = it->second;
-      } else if (it->second == meet_val_id) {
+        meet_val_id = arg_val;
+      } else if (arg_val == meet_val_id) {
         // The argument is the same constant value already computed. Continue
         // looking.
         continue;
@@ -94,7 +97,7 @@ SSAPropagator::PropStatus CCPPass::VisitPhi(Instruction* phi) {
 
   // All the operands have the same constant value represented by |meet_val_id|.
   // Set the Phi's result to that value and declare it interesting.
-  values_[phi->result_id()] = meet_val_id;
+  SetValue(phi->result_id(), meet_val_id);
   return SSAPropagator::kInteresting;
 }
 
@@ -110,12 +113,11 @@ uint32_t CCPPass::ComputeLatticeMeet(Instruction* instr, uint32_t val2) {
   // When two different values meet, the result is always varying because CCP
   // does not allow lateral transitions in the lattice.  This prevents
   // infinite cycles during propagation.
-  auto val1_it = values_.find(instr->result_id());
-  if (val1_it == values_.end()) {
+  uint32_t val1 = GetValue(instr->result_id());
+  if (val1 == kNoValue) {
     return val2;
   }
 
-  uint32_t val1 = val1_it->second;
   if (IsVaryingValue(val1)) {
     return val1;
   } else if (IsVaryingValue(val2)) {
@@ -134,13 +136,13 @@ SSAPropagator::PropStatus CCPPass::VisitAssignment(Instruction* instr) {
   // value to the LHS.
   if (instr->opcode() == spv::Op::OpCopyObject) {
     uint32_t rhs_id = instr->GetSingleWordInOperand(0);
-    auto it = values_.find(rhs_id);
-    if (it != values_.end()) {
-      if (IsVaryingValue(it->second)) {
+    const uint32_t rhs_val = GetValue(rhs_id);
+    if (rhs_val != kNoValue) {
+      if (IsVaryingValue(rhs_val)) {
         return MarkInstructionVarying(instr);
       } else {
-        uint32_t new_val = ComputeLatticeMeet(instr, it->second);
-        values_[instr->result_id()] = new_val;
+        uint32_t new_val = ComputeLatticeMeet(instr, rhs_val);
+        SetValue(instr->result_id(), new_val);
         return IsVaryingValue(new_val) ? SSAPropagator::kVarying
                                        : SSAPropagator::kInteresting;
       }
@@ -155,11 +157,11 @@ SSAPropagator::PropStatus CCPPass::VisitAssignment(Instruction* instr) {
 
   // See if the RHS of the assignment folds into a constant value.
   auto map_func = [this](uint32_t id) {
-    auto it = values_.find(id);
-    if (it == values_.end() || IsVaryingValue(it->second)) {
+    const uint32_t val = GetValue(id);
+    if (val == kNoValue || IsVaryingValue(val)) {
       return id;
     }
-    return it->second;
+    return val;
   };
   Instruction* folded_inst =
       context()->get_instruction_folder().FoldInstructionToConstant(instr,
@@ -175,27 +177,22 @@ SSAPropagator::PropStatus CCPPass::VisitAssignment(Instruction* instr) {
             IsSpecConstantInst(folded_inst->opcode())) &&
            "CCP is only interested in constant values.");
     uint32_t new_val = ComputeLatticeMeet(instr, folded_inst->result_id());
-    values_[instr->result_id()] = new_val;
+    SetValue(instr->result_id(), new_val);
     return IsVaryingValue(new_val) ? SSAPropagator::kVarying
                                    : SSAPropagator::kInteresting;
   }
 
   // Conservatively mark this instruction as varying if any input id is varying.
   if (!instr->WhileEachInId([this](uint32_t* op_id) {
-        auto iter = values_.find(*op_id);
-        if (iter != values_.end() && IsVaryingValue(iter->second)) return false;
-        return true;
+        return !IsVaryingValue(GetValue(*op_id));
       })) {
     return MarkInstructionVarying(instr);
   }
 
   // If not, see if there is a least one unknown operand to the instruction.  If
   // so, we might be able to fold it later.
-  if (!instr->WhileEachInId([this](uint32_t* op_id) {
-        auto it = values_.find(*op_id);
-        if (it == values_.end()) return false;
-        return true;
-      })) {
+  if (!instr->WhileEachInId(
+          [this](uint32_t* op_id) { return GetValue(*op_id) != kNoValue; })) {
     return SSAPropagator::kNotInteresting;
   }
 
@@ -218,15 +215,14 @@ SSAPropagator::PropStatus CCPPass::VisitBranch(Instruction* instr,
     // known value in |values_|.  If it does, set the destination block
     // according to the selector's boolean value.
     uint32_t pred_id = instr->GetSingleWordOperand(0);
-    auto it = values_.find(pred_id);
-    if (it == values_.end() || IsVaryingValue(it->second)) {
+    uint32_t pred_val_id = GetValue(pred_id);
+    if (pred_val_id == kNoValue || IsVaryingValue(pred_val_id)) {
       // The predicate has an unknown value, either branch could be taken.
       return SSAPropagator::kVarying;
     }
 
-    // Get the constant value for the predicate selector from the value table.
-    // Use it to decide which branch will be taken.
-    uint32_t pred_val_id = it->second;
+    // Use the constant value for the predicate selector from the value table
+    // to decide which branch will be taken.
     const analysis::Constant* c = const_mgr_->FindDeclaredConstant(pred_val_id);
     assert(c && "Expected to find a constant declaration for a known value.");
     // Undef values should have returned as varying above.
@@ -249,15 +245,14 @@ SSAPropagator::PropStatus CCPPass::VisitBranch(Instruction* instr,
       return SSAPropagator::kVarying;
     }
     uint32_t select_id = instr->GetSingleWordOperand(0);
-    auto it = values_.find(select_id);
-    if (it == values_.end() || IsVaryingValue(it->second)) {
+    uint32_t select_val_id = GetValue(select_id);
+    if (select_val_id == kNoValue || IsVaryingValue(select_val_id)) {
       // The selector has an unknown value, any of the branches could be taken.
       return SSAPropagator::kVarying;
     }
 
-    // Get the constant value for the selector from the value table. Use it to
-    // decide which branch will be taken.
-    uint32_t select_val_id = it->second;
+    // Use the constant value for the selector from the value table to decide
+    // which branch will be taken.
     const analysis::Constant* c =
         const_mgr_->FindDeclaredConstant(select_val_id);
     assert(c && "Expected to find a constant declaration for a known value.");
@@ -299,7 +294,7 @@ SSAPropagator::PropStatus CCPPass::VisitInstruction(Instruction* instr,
   return SSAPropagator::kVarying;
 }
 
-bool CCPPass::ReplaceValues() {
+bool CCPPass::ReplaceValues(Function* fp) {
   // Even if we make no changes to the function's IR, propagation may have
   // created new constants.  Even if those constants cannot be replaced in
   // the IR, the constant definition itself is a change.  To reflect this,
@@ -311,13 +306,21 @@ bool CCPPass::ReplaceValues() {
   // https://github.com/KhronosGroup/SPIRV-Tools/issues/3991 for details.
   bool changed_ir = (context()->module()->IdBound() > original_id_bound_);
 
-  for (const auto& it : values_) {
-    uint32_t id = it.first;
-    uint32_t cst_id = it.second;
-    if (!IsVaryingValue(cst_id) && id != cst_id) {
-      context()->KillNamesAndDecorates(id);
-      changed_ir |= context()->ReplaceAllUsesWith(id, cst_id);
+  // Only the instructions of |fp| can have a constant value other than
+  // themselves.  Collect them first, since replacing uses updates the IR.
+  std::vector<std::pair<uint32_t, uint32_t>> replacements;
+  fp->ForEachInst([this, &replacements](Instruction* inst) {
+    uint32_t id = inst->result_id();
+    uint32_t cst_id = GetValue(id);
+    if (id != 0 && cst_id != kNoValue && !IsVaryingValue(cst_id) &&
+        id != cst_id) {
+      replacements.emplace_back(id, cst_id);
     }
+  });
+  for (const auto& replacement : replacements) {
+    context()->KillNamesAndDecorates(replacement.first);
+    changed_ir |=
+        context()->ReplaceAllUsesWith(replacement.first, replacement.second);
   }
 
   return changed_ir;
@@ -330,18 +333,11 @@ bool CCPPass::PropagateConstants(Function* fp) {
 
   // Mark function parameters as varying.
   fp->ForEachParam([this](const Instruction* inst) {
-    values_[inst->result_id()] = kVaryingSSAId;
+    SetValue(inst->result_id(), kVaryingSSAId);
   });
 
-  const auto visit_fn = [this](Instruction* instr, BasicBlock** dest_bb) {
-    return VisitInstruction(instr, dest_bb);
-  };
-
-  propagator_ =
-      std::unique_ptr<SSAPropagator>(new SSAPropagator(context(), visit_fn));
-
   if (propagator_->Run(fp)) {
-    return ReplaceValues();
+    return ReplaceValues(fp);
   }
 
   return false;
@@ -349,6 +345,7 @@ bool CCPPass::PropagateConstants(Function* fp) {
 
 void CCPPass::Initialize() {
   const_mgr_ = context()->get_constant_mgr();
+  values_.assign(context()->module()->IdBound(), kNoValue);
 
   // Populate the constant table with values from constant declarations in the
   // module.  The values of each OpConstant declaration is the identity
@@ -357,9 +354,9 @@ void CCPPass::Initialize() {
     // Record compile time constant ids. Treat all other global values as
     // varying.
     if (inst.IsConstant()) {
-      values_[inst.result_id()] = inst.result_id();
+      SetValue(inst.result_id(), inst.result_id());
     } else {
-      values_[inst.result_id()] = kVaryingSSAId;
+      SetValue(inst.result_id(), kVaryingSSAId);
     }
   }
 
@@ -367,9 +364,16 @@ void CCPPass::Initialize() {
   // will not be constants, and will be used by `OpExtInst` instructions.
   // This allows those instructions to be fully processed.
   for (const auto& inst : get_module()->ext_inst_imports()) {
-    values_[inst.result_id()] = kVaryingSSAId;
+    SetValue(inst.result_id(), kVaryingSSAId);
   }
 
+  // The propagator keeps its state between functions, so that it is only
+  // allocated once.
+  const auto visit_fn = [this](Instruction* instr, BasicBlock** dest_bb) {
+    return VisitInstruction(instr, dest_bb);
+  };
+  propagator_ = MakeUnique<SSAPropagator>(context(), visit_fn);
+
   original_id_bound_ = context()->module()->IdBound();
 }
 
@@ -377,7 +381,10 @@ Pass::Status CCPPass::Process() {
   Initialize();
 
   // Process all entry point functions.
-  ProcessFunction pfn = [this](Function* fp) { return PropagateConstants(fp); };
+  ProcessFunction pfn = [this](Function* fp) {
+    if (IsFunctionUnchanged(fp)) return false;
+    return PropagateConstants(fp);
+  };
   bool modified = context()->ProcessReachableCallTree(pfn);
   if (context()->id_overflow()) return Pass::Status::Failure;
   return modified ? Pass::Status::SuccessWithChange
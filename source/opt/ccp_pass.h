@@ -16,7 +16,7 @@
 #define SOURCE_OPT_CCP_PASS_H_
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include "source/opt/constants.h"
 #include "source/opt/function.h"
@@ -35,6 +35,9 @@ class CCPPass : public MemPass {
   const char* name() const override { return "ccp"; }
   Status Process() override;
 
+  bool ReportsModifiedFunctions() const override { return true; }
+  bool SupportsIncrementalProcessing() const override { return true; }
+
   IRContext::Analysis GetPreservedAnalyses() override {
     return IRContext::kAnalysisDefUse |
            IRContext::kAnalysisInstrToBlockMapping |
@@ -78,7 +81,7 @@ class CCPPass : public MemPass {
   // Replaces all operands used in |fp| with the corresponding constant values
   // in |values_|.  Returns true if any operands were replaced, and false
   // otherwise.
-  bool ReplaceValues();
+  bool ReplaceValues(Function* fp);
 
   // Marks |instr| as varying by registering a varying value for its result
   // into the |values_| table. Returns SSAPropagator::kVarying.
@@ -88,6 +91,18 @@ class CCPPass : public MemPass {
   // value.
   bool IsVaryingValue(uint32_t id) const;
 
+  // Returns the value recorded for |id| in |values_|, or kNoValue if there is
+  // none.
+  uint32_t GetValue(uint32_t id) const {
+    return id < values_.size() ? values_[id] : kNoValue;
+  }
+
+  // Records |value| as the value of |id| in |values_|.
+  void SetValue(uint32_t id, uint32_t value) {
+    if (id >= values_.size()) values_.resize(id + 1, kNoValue);
+    values_[id] = value;
+  }
+
   // Constant manager for the parent IR context.  Used to record new constants
   // generated during propagation.
   analysis::ConstantManager* const_mgr_;
@@ -108,16 +123,20 @@ class CCPPass : public MemPass {
   // infinite cycles during propagation.
   uint32_t ComputeLatticeMeet(Instruction* instr, uint32_t val2);
 
-  // Constant value table.  Each entry <id, const_decl_id> in this map
-  // represents the compile-time constant value for |id| as declared by
-  // |const_decl_id|. Each |const_decl_id| in this table is an OpConstant
-  // declaration for the current module.
+  // The entry of |values_| for an id that has no recorded value.
+  static constexpr uint32_t kNoValue = 0;
+
+  // Constant value table, indexed by id.  Each entry <id, const_decl_id> in
+  // this table represents the compile-time constant value for |id| as
+  // declared by |const_decl_id|. Each |const_decl_id| in this table is an
+  // OpConstant declaration for the current module.  Ids without a value map to
+  // kNoValue.
   //
   // Additionally, this table keeps track of SSA IDs with varying values. If an
   // SSA ID is found to have a varying value, it will have an entry in this
   // table that maps to the special SSA id kVaryingSSAId.  These values are
   // never replaced in the IR, they are used by CCP during propagation.
-  std::unordered_map<uint32_t, uint32_t> values_;
+  std::vector<uint32_t> values_;
 
   // Propagator engine used.
   std::unique_ptr<SSAPropagator> propagator_;
@@ -20,9 +20,10 @@ namespace spvtools {
 namespace opt {
 
 bool DataFlowAnalysis::Enqueue(Instruction* inst) {
-  bool& is_enqueued = on_worklist_[inst];
-  if (is_enqueued) return false;
-  is_enqueued = true;
+  const uint32_t uid = inst->unique_id();
+  if (uid >= on_worklist_.size()) on_worklist_.resize(uid + 1, false);
+  if (on_worklist_[uid]) return false;
+  on_worklist_[uid] = true;
   worklist_.push(inst);
   return true;
 }
@@ -34,7 +35,7 @@ DataFlowAnalysis::VisitResult DataFlowAnalysis::RunOnce(
   while (!worklist_.empty()) {
     Instruction* top = worklist_.front();
     worklist_.pop();
-    on_worklist_[top] = false;
+    on_worklist_[top->unique_id()] = false;
     VisitResult result = Visit(top);
     if (result == VisitResult::kResultChanged) {
       EnqueueSuccessors(top);
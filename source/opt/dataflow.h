@@ -16,7 +16,6 @@
 #define SOURCE_OPT_DATAFLOW_H_
 
 #include <queue>
-#include <unordered_map>
 #include <vector>
 
 #include "source/opt/instruction.h"
@@ -83,7 +82,9 @@ class DataFlowAnalysis {
   VisitResult RunOnce(Function* function, bool is_first_iteration);
 
   IRContext& context_;
-  std::unordered_map<Instruction*, bool> on_worklist_;
+  // Whether each instruction is in the worklist, indexed by the unique id of
+  // the instruction.
+  std::vector<bool> on_worklist_;
   // The worklist, which contains the list of instructions to be visited.
   //
   // The choice of data structure was influenced by the data in "Iterative
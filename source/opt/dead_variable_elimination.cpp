@@ -73,14 +73,17 @@ Pass::Status DeadVariableElimination::Process() {
   bool modified = false;
   if (!ids_to_remove.empty()) {
     modified = true;
+    std::vector<Instruction*> to_kill;
     for (auto result_id : ids_to_remove) {
-      DeleteVariable(result_id);
+      DeleteVariable(result_id, &to_kill);
     }
+    context()->KillInstructions(to_kill);
   }
   return (modified ? Status::SuccessWithChange : Status::SuccessWithoutChange);
 }
 
-void DeadVariableElimination::DeleteVariable(uint32_t result_id) {
+void DeadVariableElimination::DeleteVariable(
+    uint32_t result_id, std::vector<Instruction*>* to_kill) {
   Instruction* inst = get_def_use_mgr()->GetDef(result_id);
   assert(inst->opcode() == spv::Op::OpVariable &&
          "Should not be trying to delete anything other than an OpVariable.");
@@ -102,11 +105,11 @@ void DeadVariableElimination::DeleteVariable(uint32_t result_id) {
       }
 
       if (count == 0) {
-        DeleteVariable(initializer_id);
+        DeleteVariable(initializer_id, to_kill);
       }
     }
   }
-  context()->KillDef(result_id);
+  to_kill->push_back(inst);
 }
 }  // namespace opt
 }  // namespace spvtools
@@ -17,6 +17,7 @@
 
 #include <climits>
 #include <unordered_map>
+#include <vector>
 
 #include "source/opt/decoration_manager.h"
 #include "source/opt/mem_pass.h"
@@ -35,8 +36,9 @@ class DeadVariableElimination : public MemPass {
   }
 
  private:
-  // Deletes the OpVariable instruction who result id is |result_id|.
-  void DeleteVariable(uint32_t result_id);
+  // Adds the OpVariable instruction whose result id is |result_id| to
+  // |to_kill|, along with the variables that become dead without it.
+  void DeleteVariable(uint32_t result_id, std::vector<Instruction*>* to_kill);
 
   // Keeps track of the number of references of an id.  Once that value is 0, it
   // is safe to remove the corresponding instruction.
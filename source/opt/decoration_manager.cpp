@@ -636,6 +636,10 @@ void DecorationManager::RemoveDecoration(Instruction* inst) {
   }
 }
 
+void DecorationManager::RemoveIds(const std::unordered_set<uint32_t>& ids) {
+  for (uint32_t id : ids) id_to_decoration_insts_.erase(id);
+}
+
 bool operator==(const DecorationManager& lhs, const DecorationManager& rhs) {
   return lhs.id_to_decoration_insts_ == rhs.id_to_decoration_insts_;
 }
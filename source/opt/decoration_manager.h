@@ -63,6 +63,12 @@ class DecorationManager {
   // will be removed, and no actual instruction.
   void RemoveDecoration(Instruction* inst);
 
+  // Forgets all decorations applied to the ids in |ids|.
+  //
+  // NOTE: This is only meant to be called from ir_context, when the ids are
+  // killed together with their decorations.
+  void RemoveIds(const std::unordered_set<uint32_t>& ids);
+
   // Returns a vector of all decorations affecting |id|. If a group is applied
   // to |id|, the decorations of that group are returned rather than the group
   // decoration instruction. If |include_linkage| is not set, linkage
@@ -14,6 +14,8 @@
 
 #include "source/opt/def_use_manager.h"
 
+#include <algorithm>
+
 namespace spvtools {
 namespace opt {
 namespace analysis {
@@ -28,6 +30,7 @@ void DefUseManager::AnalyzeInstDef(Instruction* inst) {
       ClearInst(iter->second);
     }
     id_to_def_[def_id] = inst;
+    highest_def_id_ = std::max(highest_def_id_, def_id);
   } else {
     ClearInst(inst);
   }
@@ -242,8 +245,22 @@ void DefUseManager::ClearInst(Instruction* inst) {
       }
       id_to_users_.erase(users_begin, new_end);
       id_to_def_.erase(inst->result_id());
+      // The new highest id is only computed when it is queried, so killing
+      // many instructions costs a single scan of |id_to_def_|.
+      if (inst->result_id() == highest_def_id_) highest_def_id_dirty_ = true;
+    }
+  }
+}
+
+uint32_t DefUseManager::highest_def_id() {
+  if (highest_def_id_dirty_) {
+    highest_def_id_ = 0;
+    for (const auto& entry : id_to_def_) {
+      highest_def_id_ = std::max(highest_def_id_, entry.first);
     }
+    highest_def_id_dirty_ = false;
   }
+  return highest_def_id_;
 }
 
 void DefUseManager::EraseUseRecordsOfOperandIds(const Instruction* inst) {
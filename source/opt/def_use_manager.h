@@ -175,6 +175,11 @@ class DefUseManager {
   // Returns the map from ids to their def instructions.
   const IdToDefMap& id_to_defs() const { return id_to_def_; }
 
+  // Returns the highest id defined by an analyzed instruction, or 0 if there
+  // is none.  This is maintained as instructions are analyzed, and recomputed
+  // from the defined ids after the instruction defining it was cleared.
+  uint32_t highest_def_id();
+
   // Clear the internal def-use record of the given instruction |inst|. This
   // method will update the use information of the operand ids of |inst|. The
   // record: |inst| uses an |id|, will be removed from the use records of |id|.
@@ -221,6 +226,10 @@ class DefUseManager {
   IdToUsersMap id_to_users_;  // Mapping from ids to their users
   // Mapping from instructions to the ids used in the instruction.
   InstToUsedIdsMap inst_to_used_ids_;
+  // The highest key of |id_to_def_|, or 0 if it is empty.  If
+  // |highest_def_id_dirty_| is true, it is only an upper bound.
+  uint32_t highest_def_id_ = 0;
+  bool highest_def_id_dirty_ = false;
 };
 
 }  // namespace analysis
@@ -51,14 +51,13 @@ Module::iterator EliminateFunction(IRContext* context,
               inst->ToNop();
             } else if (to_kill.find(inst) == to_kill.end()) {
               context->CollectNonSemanticTree(inst, &to_kill);
-              context->KillInst(inst);
+              to_kill.insert(inst);
             }
           },
           true, true);
 
-  for (auto* dead : to_kill) {
-    context->KillInst(dead);
-  }
+  context->KillInstructions(
+      std::vector<Instruction*>(to_kill.begin(), to_kill.end()));
 
   return func_iter->Erase();
 }
@@ -21,16 +21,17 @@
 
 namespace spvtools {
 namespace opt {
-
 Pass::Status InlineExhaustivePass::InlineExhaustive(Function* func) {
   bool modified = false;
   // Using block iterators here because of block erasures and insertions.
   for (auto bi = func->begin(); bi != func->end(); ++bi) {
     for (auto ii = bi->begin(); ii != bi->end();) {
-      if (IsInlinableFunctionCall(&*ii)) {
+      if (IsInlinableFunctionCall(&*ii) && IsProfitableToInline(&*ii)) {
         // Save instruction before the call to avoid redundant re-scanning.
         Instruction* prev_inst =
             (ii == bi->begin()) ? nullptr : &*std::prev(ii);
+        const uint32_t callee_id =
+            ii->GetSingleWordOperand(kSpvFunctionCallFunctionId);
 
         // Inline call.
         std::vector<std::unique_ptr<BasicBlock>> newBlocks;
@@ -38,6 +39,12 @@ Pass::Status InlineExhaustivePass::InlineExhaustive(Function* func) {
         if (!GenInlineCode(&newBlocks, &newVars, ii, bi)) {
           return Status::Failure;
         }
+        if (inline_budget_ != 0) {
+          // The call is gone, but the calls in the callee body now also
+          // appear in |func|.
+          --call_site_count_[callee_id];
+          CountCallSites(id2function_[callee_id]);
+        }
         // If call block is replaced with more than one block, point
         // succeeding phis at new last block.
         if (newBlocks.size() > 1) UpdateSucceedingPhis(newBlocks);
@@ -62,6 +69,9 @@ Pass::Status InlineExhaustivePass::InlineExhaustive(Function* func) {
   }
 
   if (modified) {
+    // The body of |func| changed, so it must be rescanned if it is inlined
+    // into one of its callers.
+    InvalidateCalleeTemplate(func->result_id());
     FixDebugDeclares(func);
   }
 
@@ -79,10 +89,44 @@ Pass::Status InlineExhaustivePass::ProcessImpl() {
   return status;
 }
 
-InlineExhaustivePass::InlineExhaustivePass() = default;
+bool InlineExhaustivePass::IsProfitableToInline(const Instruction* inst) {
+  if (inline_budget_ == 0) return true;
+
+  const uint32_t callee_id =
+      inst->GetSingleWordOperand(kSpvFunctionCallFunctionId);
+  // Inlining the only call to a function does not duplicate its body.
+  if (call_site_count_[callee_id] <= 1) return true;
+
+  Function* callee = id2function_[callee_id];
+  return GetCalleeTemplate(callee).instruction_count <= inline_budget_;
+}
+
+void InlineExhaustivePass::CountCallSites(const Function* func) {
+  func->ForEachInst([this](const Instruction* inst) {
+    if (inst->opcode() == spv::Op::OpFunctionCall) {
+      ++call_site_count_[inst->GetSingleWordOperand(
+          kSpvFunctionCallFunctionId)];
+    }
+  });
+}
+
+void InlineExhaustivePass::CountReachableCallSites() {
+  call_site_count_.clear();
+  ProcessFunction pfn = [this](Function* fp) {
+    CountCallSites(fp);
+    return false;
+  };
+  context()->ProcessReachableCallTree(pfn);
+}
+
+InlineExhaustivePass::InlineExhaustivePass() : inline_budget_(0) {}
+
+InlineExhaustivePass::InlineExhaustivePass(uint32_t inline_budget)
+    : inline_budget_(inline_budget) {}
 
 Pass::Status InlineExhaustivePass::Process() {
   InitializeInline();
+  if (inline_budget_ != 0) CountReachableCallSites();
   return ProcessImpl();
 }
 
@@ -34,15 +34,41 @@ namespace opt {
 class InlineExhaustivePass : public InlinePass {
  public:
   InlineExhaustivePass();
+  // Creates a pass that only inlines a callee if the cost model accepts it.
+  // Callees with more than |inline_budget| instructions are not inlined unless
+  // they have a single call site. A budget of 0 means no limit.
+  explicit InlineExhaustivePass(uint32_t inline_budget);
   Status Process() override;
 
-  const char* name() const override { return "inline-entry-points-exhaustive"; }
+  const char* name() const override {
+    return inline_budget_ == 0 ? "inline-entry-points-exhaustive"
+                               : "inline-entry-points-budget";
+  }
 
  private:
   // Exhaustively inline all function calls in func as well as in
   // all code that is inlined into func. Returns the status.
   Status InlineExhaustive(Function* func);
 
+  // Returns true if the cost model allows inlining the call |inst|.
+  bool IsProfitableToInline(const Instruction* inst);
+
+  // Adds the calls made by |func| to |call_site_count_|.
+  void CountCallSites(const Function* func);
+
+  // Counts the call sites of each function in the functions reachable from
+  // an entry point or an exported function.
+  void CountReachableCallSites();
+
+  // The maximum size of a callee with several call sites. 0 means no limit.
+  uint32_t inline_budget_;
+
+  // Map from function id to the number of reachable calls to that function.
+  // It is kept up to date as calls are inlined. The calls in a callee whose
+  // last call was inlined are not removed, so the counts never undercount and
+  // a body is never duplicated because of the single call site exception.
+  std::unordered_map<uint32_t, uint32_t> call_site_count_;
+
   void Initialize();
   Pass::Status ProcessImpl();
 };
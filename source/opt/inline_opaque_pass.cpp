@@ -102,6 +102,7 @@ Pass::Status InlineOpaquePass::InlineOpaque(Function* func) {
   }
 
   if (modified) {
+    InvalidateCalleeTemplate(func->result_id());
     FixDebugDeclares(func);
   }
 
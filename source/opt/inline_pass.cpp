@@ -27,7 +27,6 @@ namespace spvtools {
 namespace opt {
 namespace {
 // Indices of operands in SPIR-V instructions
-constexpr int kSpvFunctionCallFunctionId = 2;
 constexpr int kSpvFunctionCallArgumentId = 3;
 constexpr int kSpvReturnValueId = 0;
 constexpr int kSpvDebugDeclareVarInIdx = 3;
@@ -381,8 +380,9 @@ std::unique_ptr<BasicBlock> InlinePass::InlineReturn(
     const std::unordered_map<uint32_t, uint32_t>& callee2caller,
     std::vector<std::unique_ptr<BasicBlock>>* new_blocks,
     std::unique_ptr<BasicBlock> new_blk_ptr,
-    analysis::DebugInlinedAtContext* inlined_at_ctx, Function* calleeFn,
-    const Instruction* inst, uint32_t returnVarId) {
+    analysis::DebugInlinedAtContext* inlined_at_ctx,
+    const CalleeTemplate& callee_template, const Instruction* inst,
+    uint32_t returnVarId) {
   // Store return value to return variable.
   if (inst->opcode() == spv::Op::OpReturnValue) {
     assert(returnVarId != 0);
@@ -396,14 +396,8 @@ std::unique_ptr<BasicBlock> InlinePass::InlineReturn(
                  inst->GetDebugScope(), inlined_at_ctx));
   }
 
-  uint32_t returnLabelId = 0;
-  for (auto callee_block_itr = calleeFn->begin();
-       callee_block_itr != calleeFn->end(); ++callee_block_itr) {
-    if (spvOpcodeIsAbort(callee_block_itr->tail()->opcode())) {
-      returnLabelId = context()->TakeNextId();
-      break;
-    }
-  }
+  if (!callee_template.has_abort_block) return new_blk_ptr;
+  uint32_t returnLabelId = context()->TakeNextId();
   if (returnLabelId == 0) return new_blk_ptr;
 
   if (inst->opcode() == spv::Op::OpReturn ||
@@ -564,8 +558,10 @@ bool InlinePass::GenInlineCode(
     BasicBlock::iterator call_inst_itr,
     UptrVectorIterator<BasicBlock> call_block_itr) {
   // Map from all ids in the callee to their equivalent id in the caller
-  // as callee instructions are copied into caller.
-  std::unordered_map<uint32_t, uint32_t> callee2caller;
+  // as callee instructions are copied into caller. The table is owned by the
+  // pass so its buckets are reused from one call site to the next.
+  std::unordered_map<uint32_t, uint32_t>& callee2caller = callee2caller_;
+  callee2caller.clear();
   // Pre-call same-block insts
   std::unordered_map<uint32_t, Instruction*> preCallSB;
   // Post-call same-block op ids
@@ -590,6 +586,8 @@ bool InlinePass::GenInlineCode(
 
   Function* calleeFn = id2function_[call_inst_itr->GetSingleWordOperand(
       kSpvFunctionCallFunctionId)];
+  const CalleeTemplate& callee_template = GetCalleeTemplate(calleeFn);
+  callee2caller.reserve(callee_template.result_ids.size());
 
   // Map parameters to actual arguments.
   MapParams(calleeFn, call_inst_itr, &callee2caller);
@@ -636,16 +634,14 @@ bool InlinePass::GenInlineCode(
     }
   }
 
-  calleeFn->WhileEachInst([&callee2caller, this](const Instruction* cpi) {
-    // Create set of callee result ids. Used to detect forward references
-    const uint32_t rid = cpi->result_id();
-    if (rid != 0 && callee2caller.find(rid) == callee2caller.end()) {
-      const uint32_t nid = context()->TakeNextId();
-      if (nid == 0) return false;
-      callee2caller[rid] = nid;
-    }
-    return true;
-  });
+  // Map the remaining callee result ids to fresh ids. Used to detect forward
+  // references.
+  for (uint32_t rid : callee_template.result_ids) {
+    if (callee2caller.find(rid) != callee2caller.end()) continue;
+    const uint32_t nid = context()->TakeNextId();
+    if (nid == 0) break;
+    callee2caller[rid] = nid;
+  }
 
   // Inline DebugClare instructions in the callee's header.
   calleeFn->ForEachDebugInstructionsInHeader(
@@ -669,7 +665,7 @@ bool InlinePass::GenInlineCode(
   if (new_blk_ptr == nullptr) return false;
 
   new_blk_ptr = InlineReturn(callee2caller, new_blocks, std::move(new_blk_ptr),
-                             &inlined_at_ctx, calleeFn,
+                             &inlined_at_ctx, callee_template,
                              &*(calleeFn->tail()->tail()), returnVarId);
 
   // Load return value into result id of call, if it exists.
@@ -736,6 +732,26 @@ bool InlinePass::IsInlinableFunctionCall(const Instruction* inst) {
   return true;
 }
 
+const InlinePass::CalleeTemplate& InlinePass::GetCalleeTemplate(
+    Function* func) {
+  auto it = callee_templates_.find(func->result_id());
+  if (it != callee_templates_.end()) return it->second;
+
+  CalleeTemplate& callee_template = callee_templates_[func->result_id()];
+  func->ForEachInst([&callee_template](const Instruction* inst) {
+    ++callee_template.instruction_count;
+    const uint32_t rid = inst->result_id();
+    if (rid != 0) callee_template.result_ids.push_back(rid);
+  });
+  for (auto& blk : *func) {
+    if (spvOpcodeIsAbort(blk.tail()->opcode())) {
+      callee_template.has_abort_block = true;
+      break;
+    }
+  }
+  return callee_template;
+}
+
 void InlinePass::UpdateSucceedingPhis(
     std::vector<std::unique_ptr<BasicBlock>>& new_blocks) {
   const auto firstBlk = new_blocks.begin();
@@ -842,6 +858,7 @@ void InlinePass::InitializeInline() {
   id2function_.clear();
   id2block_.clear();
   inlinable_.clear();
+  callee_templates_.clear();
   no_return_in_loop_.clear();
   early_return_funcs_.clear();
   funcs_called_from_continue_ =
@@ -37,9 +37,30 @@ class InlinePass : public Pass {
   using cbb_ptr = const BasicBlock*;
 
  public:
+  // Information about a callee that does not depend on the call site. It is
+  // computed once per callee and reused for every call to that callee. The
+  // callee body itself is still cloned and its ids remapped at every call
+  // site; the template only avoids the extra scans of the body that collect
+  // this information.
+  struct CalleeTemplate {
+    // The result ids defined in the callee, in instruction order. Each of them
+    // needs a fresh id at every call site unless it is a parameter or a local
+    // variable, which are mapped separately.
+    std::vector<uint32_t> result_ids;
+    // The number of instructions in the callee body. This is the size used by
+    // the inlining cost model.
+    uint32_t instruction_count = 0;
+    // True if some block of the callee ends with an abort instruction, in which
+    // case the inlined code needs a separate return block.
+    bool has_abort_block = false;
+  };
+
   virtual ~InlinePass() override = default;
 
  protected:
+  // Index of the called function id in the operands of OpFunctionCall.
+  static constexpr int kSpvFunctionCallFunctionId = 2;
+
   InlinePass();
 
   // Add pointer to type to module and return resultId.  Returns 0 if the type
@@ -128,6 +149,15 @@ class InlinePass : public Pass {
   // Return true if |inst| is a function call that can be inlined.
   bool IsInlinableFunctionCall(const Instruction* inst);
 
+  // Returns the template for |func|, building it if it is not cached yet.
+  const CalleeTemplate& GetCalleeTemplate(Function* func);
+
+  // Drops the cached template for the function with result id |func_id|. This
+  // must be called whenever code is inlined into that function.
+  void InvalidateCalleeTemplate(uint32_t func_id) {
+    callee_templates_.erase(func_id);
+  }
+
   // Return true if |func| has no return in a loop. The current analysis
   // requires structured control flow, so return false if control flow not
   // structured ie. module is not a shader.
@@ -179,6 +209,13 @@ class InlinePass : public Pass {
   // continue construct.
   std::unordered_set<uint32_t> funcs_called_from_continue_;
 
+  // Map from function's result id to its cached callee template.
+  std::unordered_map<uint32_t, CalleeTemplate> callee_templates_;
+
+  // Map from callee id to caller id, reused between calls to GenInlineCode to
+  // avoid reallocating the hash table for every call site.
+  std::unordered_map<uint32_t, uint32_t> callee2caller_;
+
  private:
   // Moves instructions of the caller function up to the call instruction
   // to |new_blk_ptr|.
@@ -212,8 +249,9 @@ class InlinePass : public Pass {
       const std::unordered_map<uint32_t, uint32_t>& callee2caller,
       std::vector<std::unique_ptr<BasicBlock>>* new_blocks,
       std::unique_ptr<BasicBlock> new_blk_ptr,
-      analysis::DebugInlinedAtContext* inlined_at_ctx, Function* calleeFn,
-      const Instruction* inst, uint32_t returnVarId);
+      analysis::DebugInlinedAtContext* inlined_at_ctx,
+      const CalleeTemplate& callee_template, const Instruction* inst,
+      uint32_t returnVarId);
 
   // Inlines the entry block of the callee function.
   bool InlineEntryBlock(
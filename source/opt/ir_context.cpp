@@ -200,12 +200,155 @@ Instruction* IRContext::KillInst(Instruction* inst) {
 
   KillRelatedDebugScopes(inst);
 
+  RemoveFromAnalyses(inst);
+
+  Instruction* next_instruction = nullptr;
+  if (inst->IsInAList()) {
+    next_instruction = inst->NextNode();
+    inst->RemoveFromList();
+    delete inst;
+  } else {
+    // Needed for instructions that are not part of a list like OpLabels,
+    // OpFunction, OpFunctionEnd, etc..
+    inst->ToNop();
+  }
+  return next_instruction;
+}
+
+void IRContext::KillInstructions(const std::vector<Instruction*>& insts) {
+  std::vector<Instruction*> batch;
+  std::unordered_set<Instruction*> in_batch;
+  std::unordered_set<uint32_t> dead_ids;
+  std::unordered_set<uint32_t> dead_functions;
+  std::unordered_set<uint32_t> dead_globals;
+  const auto add_to_batch = [&](Instruction* inst) {
+    if (!inst || !in_batch.insert(inst).second) return;
+    batch.push_back(inst);
+    const uint32_t id = inst->result_id();
+    if (id == 0) return;
+    dead_ids.insert(id);
+    if (inst->opcode() == spv::Op::OpFunction) {
+      dead_functions.insert(id);
+    } else if (inst->opcode() == spv::Op::OpVariable ||
+               IsConstantInst(inst->opcode())) {
+      dead_globals.insert(id);
+    }
+  };
+  for (Instruction* inst : insts) add_to_batch(inst);
+  if (batch.empty()) return;
+
+  if (!dead_ids.empty()) {
+    // Kill the names of the dead ids.
+    for (auto& name : module()->debugs2()) {
+      if ((name.opcode() == spv::Op::OpName ||
+           name.opcode() == spv::Op::OpMemberName) &&
+          dead_ids.count(name.GetSingleWordInOperand(0))) {
+        add_to_batch(&name);
+      }
+    }
+
+    // Kill the decorations of the dead ids, and remove them from the targets
+    // of the decoration groups that outlive them.
+    if (AreAnalysesValid(kAnalysisDecorations)) {
+      get_decoration_mgr()->RemoveIds(dead_ids);
+    }
+    for (auto& annotation : module()->annotations()) {
+      switch (annotation.opcode()) {
+        case spv::Op::OpDecorate:
+        case spv::Op::OpDecorateId:
+        case spv::Op::OpDecorateStringGOOGLE:
+        case spv::Op::OpMemberDecorate:
+          if (dead_ids.count(annotation.GetSingleWordInOperand(0))) {
+            add_to_batch(&annotation);
+          }
+          break;
+        case spv::Op::OpGroupDecorate:
+        case spv::Op::OpGroupMemberDecorate: {
+          if (dead_ids.count(annotation.GetSingleWordInOperand(0))) {
+            add_to_batch(&annotation);
+            break;
+          }
+          const uint32_t stride =
+              annotation.opcode() == spv::Op::OpGroupDecorate ? 1u : 2u;
+          Instruction::OperandList live_targets;
+          live_targets.push_back(annotation.GetInOperand(0));
+          for (uint32_t i = 1; i < annotation.NumInOperands(); i += stride) {
+            if (dead_ids.count(annotation.GetSingleWordInOperand(i))) continue;
+            for (uint32_t j = i; j < i + stride; ++j) {
+              live_targets.push_back(annotation.GetInOperand(j));
+            }
+          }
+          if (live_targets.size() == annotation.NumInOperands()) break;
+          if (live_targets.size() == 1) {
+            add_to_batch(&annotation);
+            break;
+          }
+          ForgetUses(&annotation);
+          annotation.SetInOperands(std::move(live_targets));
+          AnalyzeUses(&annotation);
+        } break;
+        default:
+          break;
+      }
+    }
+  }
+
+  // Change the dead function and global variable operands of debug
+  // instructions to DebugInfoNone.
+  if (!dead_functions.empty() || !dead_globals.empty()) {
+    for (auto& dbg_inst : module()->ext_inst_debuginfo()) {
+      uint32_t operand_index = 0;
+      const std::unordered_set<uint32_t>* dead = nullptr;
+      if (dbg_inst.GetOpenCL100DebugOpcode() ==
+          OpenCLDebugInfo100DebugFunction) {
+        operand_index = kDebugFunctionOperandFunctionIndex;
+        dead = &dead_functions;
+      } else if (dbg_inst.GetCommonDebugOpcode() ==
+                 CommonDebugInfoDebugGlobalVariable) {
+        operand_index = kDebugGlobalVariableOperandVariableIndex;
+        dead = &dead_globals;
+      } else {
+        continue;
+      }
+      auto& operand = dbg_inst.GetOperand(operand_index);
+      if (!dead->count(operand.words[0])) continue;
+      operand.words[0] = get_debug_info_mgr()->GetDebugInfoNone()->result_id();
+      get_def_use_mgr()->AnalyzeInstUse(&dbg_inst);
+    }
+  }
+
+  // The def-use records refer to other instructions of the batch, so all of
+  // them must be cleared before anything is deleted.
+  for (Instruction* inst : batch) {
+    KillRelatedDebugScopes(inst);
+    RemoveFromAnalyses(inst);
+  }
+
+  // Instructions that are not in a list, like OpLabel or the debug line
+  // instructions attached to another instruction, are turned into OpNop before
+  // any instruction that may own them is deleted.
+  std::vector<Instruction*> to_delete;
+  for (Instruction* inst : batch) {
+    if (inst->IsInAList()) {
+      to_delete.push_back(inst);
+    } else {
+      inst->ToNop();
+    }
+  }
+  for (Instruction* inst : to_delete) {
+    inst->RemoveFromList();
+    delete inst;
+  }
+}
+
+void IRContext::RemoveFromAnalyses(Instruction* inst) {
   if (AreAnalysesValid(kAnalysisDefUse)) {
     analysis::DefUseManager* def_use_mgr = get_def_use_mgr();
     def_use_mgr->ClearInst(inst);
     for (auto& l_inst : inst->dbg_line_insts()) def_use_mgr->ClearInst(&l_inst);
   }
   if (AreAnalysesValid(kAnalysisInstrToBlockMapping)) {
+    MarkInstructionModified(inst);
     instr_to_block_.erase(inst);
   }
   if (AreAnalysesValid(kAnalysisDecorations)) {
@@ -237,18 +380,6 @@ Instruction* IRContext::KillInst(Instruction* inst) {
   }
 
   RemoveFromIdToName(inst);
-
-  Instruction* next_instruction = nullptr;
-  if (inst->IsInAList()) {
-    next_instruction = inst->NextNode();
-    inst->RemoveFromList();
-    delete inst;
-  } else {
-    // Needed for instructions that are not part of a list like OpLabels,
-    // OpFunction, OpFunctionEnd, etc..
-    inst->ToNop();
-  }
-  return next_instruction;
 }
 
 bool IRContext::KillInstructionIf(Module::inst_iterator begin,
@@ -407,6 +538,10 @@ bool IRContext::IsConsistent() {
     if (!CompareAndPrintDifferences(*get_def_use_mgr(), new_def_use)) {
       return false;
     }
+    if (get_def_use_mgr()->highest_def_id() + 1 !=
+        module()->ComputeIdBound()) {
+      return false;
+    }
   }
 
   if (AreAnalysesValid(kAnalysisIdToFuncMapping)) {
@@ -497,6 +632,7 @@ bool IRContext::IsConsistent() {
 }
 
 void IRContext::ForgetUses(Instruction* inst) {
+  MarkInstructionModified(inst);
   if (AreAnalysesValid(kAnalysisDefUse)) {
     get_def_use_mgr()->EraseUseRecordsOfOperandIds(inst);
   }
@@ -512,6 +648,7 @@ void IRContext::ForgetUses(Instruction* inst) {
 }
 
 void IRContext::AnalyzeUses(Instruction* inst) {
+  MarkInstructionModified(inst);
   if (AreAnalysesValid(kAnalysisDefUse)) {
     get_def_use_mgr()->AnalyzeInstUse(inst);
   }
@@ -1104,13 +1241,26 @@ bool IRContext::ProcessCallTreeFromRoots(ProcessFunction& pfn,
     if (done.insert(fi).second) {
       Function* fn = GetFunction(fi);
       assert(fn && "Trying to process a function that does not exist.");
-      modified = pfn(fn) || modified;
+      if (pfn(fn)) {
+        MarkFunctionModified(fn);
+        modified = true;
+      }
       AddCalls(fn, roots);
     }
   }
   return modified;
 }
 
+uint32_t IRContext::GetFunctionEpoch(const Function* func) const {
+  auto it = function_epochs_.find(func->result_id());
+  if (it == function_epochs_.end()) return all_functions_epoch_;
+  return std::max(it->second, all_functions_epoch_);
+}
+
+void IRContext::MarkFunctionModified(const Function* func) {
+  function_epochs_[func->result_id()] = ++modification_epoch_;
+}
+
 void IRContext::CollectCallTreeFromRoots(unsigned entryId,
                                          std::unordered_set<uint32_t>* funcs) {
   std::queue<uint32_t> roots;
@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -111,7 +112,11 @@ class IRContext {
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
         preserve_spec_constants_(false),
-        id_overflow_(false) {
+        id_overflow_(false),
+        modification_epoch_(1),
+        all_functions_epoch_(1),
+        track_instruction_modifications_(false),
+        skip_unchanged_functions_(false) {
     SetContextMessageConsumer(syntax_context_, consumer_);
     module_->SetContext(this);
   }
@@ -130,7 +135,11 @@ class IRContext {
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
         preserve_spec_constants_(false),
-        id_overflow_(false) {
+        id_overflow_(false),
+        modification_epoch_(1),
+        all_functions_epoch_(1),
+        track_instruction_modifications_(false),
+        skip_unchanged_functions_(false) {
     SetContextMessageConsumer(syntax_context_, consumer_);
     module_->SetContext(this);
     InitializeCombinators();
@@ -333,6 +342,9 @@ class IRContext {
     if (AreAnalysesValid(kAnalysisInstrToBlockMapping)) {
       instr_to_block_[inst] = block;
     }
+    if (block->GetParent() != nullptr) {
+      MarkFunctionModified(block->GetParent());
+    }
   }
 
   // Returns a pointer the decoration manager.  If the decoration manager is
@@ -444,6 +456,17 @@ class IRContext {
   // instruction exists.
   Instruction* KillInst(Instruction* inst);
 
+  // Deletes every instruction in |insts| as KillInst would, along with the
+  // names and decorations of the ids they define.  The analyses are updated
+  // for the whole batch before anything is deleted, and the names, annotations
+  // and debug instructions are each filtered once for all the dead ids, so
+  // this is linear in the size of the batch where calling KillInst on each
+  // instruction rescans those sections every time.
+  //
+  // Null pointers and duplicates in |insts| are ignored.  Pointers and
+  // iterators pointing to the deleted instructions become invalid.
+  void KillInstructions(const std::vector<Instruction*>& insts);
+
   // Deletes all the instruction in the range [`begin`; `end`[, for which the
   // unary predicate `condition` returned true.
   // Returns true if at least one instruction was removed, false otherwise.
@@ -590,6 +613,18 @@ class IRContext {
     return next_id;
   }
 
+  // Returns one more than the highest id used in the module.  Since every used
+  // id is defined, this comes from the def-use analysis while it is valid,
+  // which keeps track of the highest defined id.  It is O(1) unless the
+  // instruction defining that id was killed, in which case the defined ids are
+  // scanned once.  Otherwise the whole module is scanned.
+  uint32_t ComputeIdBound() {
+    if (AreAnalysesValid(kAnalysisDefUse)) {
+      return get_def_use_mgr()->highest_def_id() + 1;
+    }
+    return module()->ComputeIdBound();
+  }
+
   // Returns true if an ID overflow has occurred since the last time the flag
   // was cleared.
   bool id_overflow() const { return id_overflow_; }
@@ -677,21 +712,77 @@ class IRContext {
 
   // Applies |pfn| to every function in the call trees that are rooted at the
   // entry points.  Returns true if any call |pfn| returns true.  By convention
-  // |pfn| should return true if it modified the module.
+  // |pfn| should return true if it modified the module, and the functions for
+  // which it does are marked as modified.
   bool ProcessEntryPointCallTree(ProcessFunction& pfn);
 
   // Applies |pfn| to every function in the call trees rooted at the entry
   // points and exported functions.  Returns true if any call |pfn| returns
-  // true.  By convention |pfn| should return true if it modified the module.
+  // true.  By convention |pfn| should return true if it modified the module,
+  // and the functions for which it does are marked as modified.
   bool ProcessReachableCallTree(ProcessFunction& pfn);
 
   // Applies |pfn| to every function in the call trees rooted at the elements of
   // |roots|.  Returns true if any call to |pfn| returns true.  By convention
-  // |pfn| should return true if it modified the module.  After returning
-  // |roots| will be empty.
+  // |pfn| should return true if it modified the module, and the functions for
+  // which it does are marked as modified.  After returning |roots| will be
+  // empty.
   bool ProcessCallTreeFromRoots(ProcessFunction& pfn,
                                 std::queue<uint32_t>* roots);
 
+  // Returns the modification epoch of |func|.  Epochs increase monotonically,
+  // so a pass that remembers |current_epoch()| when it finishes can later tell
+  // whether |func| has changed since then.  Functions that have never been
+  // marked as modified report the epoch of the last call to
+  // |MarkAllFunctionsModified|.
+  uint32_t GetFunctionEpoch(const Function* func) const;
+
+  // Records that |func| has been modified.
+  void MarkFunctionModified(const Function* func);
+
+  // Records that every function in the module may have been modified.  This is
+  // used when a pass changes the module without reporting which functions it
+  // changed.
+  void MarkAllFunctionsModified() {
+    all_functions_epoch_ = ++modification_epoch_;
+  }
+
+  // Returns the epoch of the most recent modification.
+  uint32_t current_epoch() const { return modification_epoch_; }
+
+  // Returns the epoch recorded by the last call to |RecordPassEpoch| with
+  // |key|, or 0 if there was no such call.  Every function is considered
+  // modified after epoch 0.
+  uint32_t GetPassEpoch(const std::string& key) const {
+    auto it = pass_epochs_.find(key);
+    return it != pass_epochs_.end() ? it->second : 0;
+  }
+
+  // Records the current epoch as the last time the pass identified by |key|
+  // processed the whole module.
+  void RecordPassEpoch(const std::string& key) {
+    pass_epochs_[key] = modification_epoch_;
+  }
+
+  // Returns true if passes that support it should skip functions that have not
+  // been modified since they last processed them.
+  bool skip_unchanged_functions() const { return skip_unchanged_functions_; }
+  void set_skip_unchanged_functions(bool skip) {
+    skip_unchanged_functions_ = skip;
+    if (skip) EnableModificationTracking();
+  }
+
+  // Makes the def-use mutation hooks mark the function containing the mutated
+  // instruction as modified.  This is off by default, since it costs a lookup
+  // for every mutation, and must be turned on before the function epochs are
+  // read.  Turning it on marks every function as modified, since the earlier
+  // changes were not tracked.
+  void EnableModificationTracking() {
+    if (track_instruction_modifications_) return;
+    track_instruction_modifications_ = true;
+    MarkAllFunctionsModified();
+  }
+
   // Emits a error message to the message consumer indicating the error
   // described by |message| occurred in |inst|.
   void EmitErrorMessage(std::string message, Instruction* inst);
@@ -716,6 +807,10 @@ class IRContext {
   spv_target_env GetTargetEnv() const { return syntax_context_->target_env; }
 
  private:
+  // Removes |inst| from every valid analysis, without touching its names,
+  // decorations or debug instructions that refer to it.
+  void RemoveFromAnalyses(Instruction* inst);
+
   // Builds the def-use manager from scratch, even if it was already valid.
   void BuildDefUseManager() {
     def_use_mgr_ = MakeUnique<analysis::DefUseManager>(module());
@@ -869,6 +964,12 @@ class IRContext {
   // Add |var_id| to all entry points in module.
   void AddVarToEntryPoints(uint32_t var_id);
 
+  // Marks the function containing |inst| as modified.  Does nothing if
+  // modification tracking is off, the instruction-to-block mapping is not
+  // valid or |inst| is not in a function.  Passes that report the functions
+  // they modify must therefore not rely on this alone.
+  inline void MarkInstructionModified(const Instruction* inst);
+
   // The SPIR-V syntax context containing grammar tables for opcodes and
   // operands.
   spv_context syntax_context_;
@@ -980,6 +1081,28 @@ class IRContext {
 
   // Set to true if TakeNextId() fails.
   bool id_overflow_;
+
+  // The epoch of the most recent modification to a function in |module_|.
+  uint32_t modification_epoch_;
+
+  // The epoch at which all functions were last marked as modified.
+  uint32_t all_functions_epoch_;
+
+  // A map from a function's result id to the epoch at which it was last marked
+  // as modified.
+  std::unordered_map<uint32_t, uint32_t> function_epochs_;
+
+  // A map from a pass key to the epoch at which that pass last processed the
+  // module.  See |RecordPassEpoch|.
+  std::unordered_map<std::string, uint32_t> pass_epochs_;
+
+  // Whether the def-use mutation hooks mark functions as modified.  See
+  // |EnableModificationTracking|.
+  bool track_instruction_modifications_;
+
+  // Whether passes should skip functions that have not changed since they
+  // last processed them.
+  bool skip_unchanged_functions_;
 };
 
 inline IRContext::Analysis operator|(IRContext::Analysis lhs,
@@ -1273,25 +1396,41 @@ void IRContext::AddGlobalValue(std::unique_ptr<Instruction>&& v) {
 }
 
 void IRContext::AddFunctionDeclaration(std::unique_ptr<Function>&& f) {
+  MarkFunctionModified(f.get());
   module()->AddFunctionDeclaration(std::move(f));
 }
 
 void IRContext::AddFunction(std::unique_ptr<Function>&& f) {
+  MarkFunctionModified(f.get());
   module()->AddFunction(std::move(f));
 }
 
 void IRContext::AnalyzeDefUse(Instruction* inst) {
+  MarkInstructionModified(inst);
   if (AreAnalysesValid(kAnalysisDefUse)) {
     get_def_use_mgr()->AnalyzeInstDefUse(inst);
   }
 }
 
 void IRContext::UpdateDefUse(Instruction* inst) {
+  MarkInstructionModified(inst);
   if (AreAnalysesValid(kAnalysisDefUse)) {
     get_def_use_mgr()->UpdateDefUse(inst);
   }
 }
 
+void IRContext::MarkInstructionModified(const Instruction* inst) {
+  if (!track_instruction_modifications_ ||
+      !AreAnalysesValid(kAnalysisInstrToBlockMapping)) {
+    return;
+  }
+  auto entry = instr_to_block_.find(const_cast<Instruction*>(inst));
+  if (entry == instr_to_block_.end()) return;
+  if (Function* func = entry->second->GetParent()) {
+    MarkFunctionModified(func);
+  }
+}
+
 void IRContext::BuildIdToNameMap() {
   id_to_name_ = MakeUnique<std::multimap<uint32_t, Instruction*>>();
   for (Instruction& debug_inst : debugs2()) {
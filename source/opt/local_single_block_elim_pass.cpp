@@ -218,6 +218,7 @@ Pass::Status LocalSingleBlockLoadStoreElimPass::ProcessImpl() {
   if (!AllExtensionsSupported()) return Status::SuccessWithoutChange;
   // Process all entry point functions
   ProcessFunction pfn = [this](Function* fp) {
+    if (IsFunctionUnchanged(fp)) return false;
     return LocalSingleBlockLoadStoreElim(fp);
   };
 
@@ -41,6 +41,9 @@ class LocalSingleBlockLoadStoreElimPass : public MemPass {
   const char* name() const override { return "eliminate-local-single-block"; }
   Status Process() override;
 
+  bool ReportsModifiedFunctions() const override { return true; }
+  bool SupportsIncrementalProcessing() const override { return true; }
+
   IRContext::Analysis GetPreservedAnalyses() override {
     return IRContext::kAnalysisDefUse |
            IRContext::kAnalysisInstrToBlockMapping |
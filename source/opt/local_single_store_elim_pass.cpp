@@ -74,6 +74,7 @@ Pass::Status LocalSingleStoreElimPass::ProcessImpl() {
   if (!AllExtensionsSupported()) return Status::SuccessWithoutChange;
   // Process all entry point functions
   ProcessFunction pfn = [this](Function* fp) {
+    if (IsFunctionUnchanged(fp)) return false;
     return LocalSingleStoreElim(fp);
   };
   bool modified = context()->ProcessReachableCallTree(pfn);
@@ -44,6 +44,9 @@ class LocalSingleStoreElimPass : public Pass {
   const char* name() const override { return "eliminate-local-single-store"; }
   Status Process() override;
 
+  bool ReportsModifiedFunctions() const override { return true; }
+  bool SupportsIncrementalProcessing() const override { return true; }
+
   IRContext::Analysis GetPreservedAnalyses() override {
     return IRContext::kAnalysisDefUse |
            IRContext::kAnalysisInstrToBlockMapping |
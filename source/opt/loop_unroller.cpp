@@ -14,8 +14,10 @@
 
 #include "source/opt/loop_unroller.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -72,6 +74,21 @@ constexpr uint32_t kLoopControlDontUnrollIndex = 2;
 // Operand index of the loop control parameter of the OpLoopMerge.
 constexpr uint32_t kLoopControlIndex = 2;
 
+// Largest factor picked by the automatic mode when it cannot fully unroll a
+// loop.
+constexpr size_t kMaxAutoUnrollFactor = 8;
+
+// Returns the estimated register pressure of a loop unrolled by |factor|, when
+// |live_in| values are live into the loop and its pressure is |registers|. The
+// values live into the loop stay live, and the temporaries of every copy of the
+// body are assumed to be live at the same time, since later passes are free to
+// interleave the copies.
+size_t EstimateUnrolledPressure(size_t live_in, size_t registers,
+                                size_t factor) {
+  const size_t temporaries = registers > live_in ? registers - live_in : 0;
+  return live_in + temporaries * factor;
+}
+
 // This utility class encapsulates some of the state we need to maintain between
 // loop unrolls. Specifically it maintains key blocks and the induction variable
 // in the current loop duplication step and the blocks from the previous one.
@@ -1182,13 +1199,135 @@ void LoopUtils::Finalize() {
  *
  */
 
+size_t LoopUnroller::ChooseUnrollFactor(size_t trip_count, size_t body_size,
+                                        size_t live_in, size_t registers,
+                                        const char** reason) const {
+  if (trip_count == 0) {
+    *reason = "its body never runs";
+    return 0;
+  }
+
+  const auto fits = [this, body_size, live_in, registers](size_t factor) {
+    return body_size * (factor - 1) <= remaining_budget_ &&
+           EstimateUnrolledPressure(live_in, registers, factor) <=
+               limits_.max_registers;
+  };
+
+  // Removing the loop altogether is the best outcome.
+  if (fits(trip_count)) return trip_count;
+
+  // Otherwise use the largest factor that divides the trip count, so that no
+  // residual loop is needed.
+  for (size_t factor = std::min(kMaxAutoUnrollFactor, trip_count - 1);
+       factor >= 2; --factor) {
+    if (trip_count % factor == 0 && fits(factor)) return factor;
+  }
+
+  if (body_size > remaining_budget_) {
+    *reason = "the instruction budget is exhausted";
+  } else if (EstimateUnrolledPressure(live_in, registers, 2) >
+             limits_.max_registers) {
+    *reason = "its register pressure is too high";
+  } else {
+    *reason = "no factor within the limits divides its trip count";
+  }
+  return 0;
+}
+
+bool LoopUnroller::AutoUnroll(Function* f, bool* changed) {
+  struct Candidate {
+    Loop* loop;
+    size_t trip_count;
+    size_t body_size;
+    size_t live_in;
+    size_t registers;
+  };
+
+  // Measure every candidate before unrolling any of them, while the register
+  // liveness of the function is still accurate.  An outer loop only becomes a
+  // candidate once its inner loops are gone, on a later run of the pass.
+  LoopDescriptor* LD = context()->GetLoopDescriptor(f);
+  const RegisterLiveness* liveness = nullptr;
+  std::vector<Candidate> candidates;
+  for (Loop& loop : *LD) {
+    LoopUtils loop_utils{context(), &loop};
+    if (!loop_utils.CanPerformUnroll()) continue;
+
+    const Instruction* merge = loop.GetHeaderBlock()->GetLoopMergeInst();
+    if (merge->GetSingleWordInOperand(kLoopControlIndex) &
+        uint32_t(spv::LoopControlMask::DontUnroll)) {
+      continue;
+    }
+
+    // CanPerformUnroll has checked that the trip count is known.
+    const BasicBlock* condition = loop.FindConditionBlock();
+    const Instruction* induction = loop.FindConditionVariable(condition);
+    size_t trip_count = 0;
+    loop.FindNumberOfIterations(induction, &*condition->ctail(), &trip_count);
+
+    CodeMetrics metrics;
+    metrics.Analyze(loop);
+
+    if (!liveness) liveness = context()->GetLivenessAnalysis()->Get(f);
+    RegisterLiveness::RegionRegisterLiveness pressure;
+    liveness->ComputeLoopRegisterPressure(loop, &pressure);
+
+    candidates.push_back({&loop, trip_count, metrics.roi_size_,
+                          pressure.live_in_.size(), pressure.used_registers_});
+  }
+
+  for (const Candidate& candidate : candidates) {
+    const char* reason = nullptr;
+    const size_t factor = ChooseUnrollFactor(
+        candidate.trip_count, candidate.body_size, candidate.live_in,
+        candidate.registers, &reason);
+
+    std::string message =
+        "loop-unroll: loop %" +
+        std::to_string(candidate.loop->GetHeaderBlock()->id()) + " (" +
+        std::to_string(candidate.trip_count) + " iterations, " +
+        std::to_string(candidate.body_size) + " instructions, " +
+        std::to_string(candidate.registers) + " registers): ";
+    if (factor == 0) {
+      message += std::string("not unrolled because ") + reason;
+    } else if (factor >= candidate.trip_count) {
+      message += "fully unrolled";
+    } else {
+      message += "unrolled by a factor of " + std::to_string(factor);
+    }
+    if (consumer()) {
+      consumer()(SPV_MSG_INFO, "", {0, 0, 0}, message.c_str());
+    }
+    if (factor == 0) continue;
+
+    LoopUtils loop_utils{context(), candidate.loop};
+    const bool unrolled = factor >= candidate.trip_count
+                              ? loop_utils.FullyUnroll()
+                              : loop_utils.PartiallyUnroll(factor);
+    if (!unrolled) return false;
+    remaining_budget_ -= candidate.body_size * (factor - 1);
+    *changed = true;
+  }
+
+  LD->PostModificationCleanup();
+  return true;
+}
+
 Pass::Status LoopUnroller::Process() {
   bool changed = false;
+  remaining_budget_ = limits_.instruction_budget;
   for (Function& f : *context()->module()) {
     if (f.IsDeclaration()) {
       continue;
     }
 
+    if (auto_unroll_) {
+      if (!AutoUnroll(&f, &changed)) {
+        return Status::Failure;
+      }
+      continue;
+    }
+
     LoopDescriptor* LD = context()->GetLoopDescriptor(&f);
     for (Loop& loop : *LD) {
       LoopUtils loop_utils{context(), &loop};
@@ -15,6 +15,8 @@
 #ifndef SOURCE_OPT_LOOP_UNROLLER_H_
 #define SOURCE_OPT_LOOP_UNROLLER_H_
 
+#include <cstddef>
+
 #include "source/opt/pass.h"
 
 namespace spvtools {
@@ -22,9 +24,31 @@ namespace opt {
 
 class LoopUnroller : public Pass {
  public:
-  LoopUnroller() : Pass(), fully_unroll_(true), unroll_factor_(0) {}
+  // Limits of the automatic selection of unroll factors.
+  struct AutoUnrollLimits {
+    // Maximum number of instructions the pass may add to the module.
+    size_t instruction_budget;
+    // Maximum estimated register pressure of an unrolled loop.
+    size_t max_registers;
+  };
+
+  LoopUnroller()
+      : Pass(), fully_unroll_(true), unroll_factor_(0), auto_unroll_(false) {}
   LoopUnroller(bool fully_unroll, int unroll_factor)
-      : Pass(), fully_unroll_(fully_unroll), unroll_factor_(unroll_factor) {}
+      : Pass(),
+        fully_unroll_(fully_unroll),
+        unroll_factor_(unroll_factor),
+        auto_unroll_(false) {}
+
+  // Creates an unroller that picks the factor of every loop which is not
+  // marked DontUnroll from its size, its trip count and its register pressure,
+  // within |limits|.
+  explicit LoopUnroller(const AutoUnrollLimits& limits)
+      : Pass(),
+        fully_unroll_(false),
+        unroll_factor_(0),
+        auto_unroll_(true),
+        limits_(limits) {}
 
   const char* name() const override { return "loop-unroll"; }
 
@@ -39,8 +63,26 @@ class LoopUnroller : public Pass {
   }
 
  private:
+  // Unrolls the loops of |f| with the factors picked by the cost model, and
+  // reports every decision through the message consumer.  Returns false if an
+  // unroll fails.  Sets |changed| if a loop was unrolled.
+  bool AutoUnroll(Function* f, bool* changed);
+
+  // Returns the unroll factor, within the remaining budget, of a loop running
+  // |trip_count| iterations of |body_size| instructions, into which |live_in|
+  // values are live and whose register pressure is |registers|.  A factor of
+  // at least |trip_count| means a full unroll.  Returns 0 and sets |reason| if
+  // the loop should not be unrolled.
+  size_t ChooseUnrollFactor(size_t trip_count, size_t body_size,
+                            size_t live_in, size_t registers,
+                            const char** reason) const;
+
   bool fully_unroll_;
   int unroll_factor_;
+  bool auto_unroll_;
+  AutoUnrollLimits limits_{0, 0};
+  // Instructions that the automatic mode may still add to the module.
+  size_t remaining_budget_ = 0;
 };
 
 }  // namespace opt
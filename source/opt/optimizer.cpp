@@ -99,6 +99,20 @@ Optimizer& Optimizer::RegisterPass(PassToken&& p) {
   return *this;
 }
 
+Optimizer& Optimizer::RegisterFixedPointPasses(
+    std::vector<std::function<PassToken()>> passes, uint32_t max_iterations) {
+  std::vector<opt::PassManager::PassFactory> factories;
+  factories.reserve(passes.size());
+  for (auto& create_pass : passes) {
+    factories.push_back([create_pass]() -> std::unique_ptr<opt::Pass> {
+      PassToken token = create_pass();
+      return std::move(token.impl_->pass);
+    });
+  }
+  impl_->pass_manager.AddFixedPointGroup(std::move(factories), max_iterations);
+  return *this;
+}
+
 // The legalization passes take a spir-v shader generated by an HLSL front-end
 // and turn it into a valid vulkan spir-v shader.  There are two ways in which
 // the code will be invalid at the start:
@@ -181,6 +195,18 @@ Optimizer& Optimizer::RegisterLegalizationPasses() {
 }
 
 Optimizer& Optimizer::RegisterPerformancePasses(bool preserve_interface) {
+  // The clean-up sequences below used to be repeated a fixed number of times.
+  // They are now run to a fixed point, which stops as soon as a repetition
+  // would make no change.  The first iteration of each group runs the same
+  // passes as the original sequence, and each group ends with the pass that
+  // ended that sequence, so that it is also the last to run when the
+  // iteration limit is reached.
+  constexpr uint32_t kMaxCleanupIterations = 4;
+  auto adce = [preserve_interface]() {
+    return CreateAggressiveDCEPass(preserve_interface);
+  };
+  auto scalar_replacement = []() { return CreateScalarReplacementPass(0); };
+
   return RegisterPass(CreateWrapOpKillPass())
       .RegisterPass(CreateDeadBranchElimPass())
       .RegisterPass(CreateMergeReturnPass())
@@ -191,11 +217,11 @@ Optimizer& Optimizer::RegisterPerformancePasses(bool preserve_interface) {
       .RegisterPass(CreateLocalSingleBlockLoadStoreElimPass())
       .RegisterPass(CreateLocalSingleStoreElimPass())
       .RegisterPass(CreateAggressiveDCEPass(preserve_interface))
-      .RegisterPass(CreateScalarReplacementPass(0))
-      .RegisterPass(CreateLocalAccessChainConvertPass())
-      .RegisterPass(CreateLocalSingleBlockLoadStoreElimPass())
-      .RegisterPass(CreateLocalSingleStoreElimPass())
-      .RegisterPass(CreateAggressiveDCEPass(preserve_interface))
+      .RegisterFixedPointPasses(
+          {scalar_replacement, CreateLocalAccessChainConvertPass,
+           CreateLocalSingleBlockLoadStoreElimPass,
+           CreateLocalSingleStoreElimPass, adce},
+          kMaxCleanupIterations)
       .RegisterPass(CreateLocalMultiStoreElimPass())
       .RegisterPass(CreateAggressiveDCEPass(preserve_interface))
       .RegisterPass(CreateCCPPass())
@@ -205,11 +231,11 @@ Optimizer& Optimizer::RegisterPerformancePasses(bool preserve_interface) {
       .RegisterPass(CreateRedundancyEliminationPass())
       .RegisterPass(CreateCombineAccessChainsPass())
       .RegisterPass(CreateSimplificationPass())
-      .RegisterPass(CreateScalarReplacementPass(0))
-      .RegisterPass(CreateLocalAccessChainConvertPass())
-      .RegisterPass(CreateLocalSingleBlockLoadStoreElimPass())
-      .RegisterPass(CreateLocalSingleStoreElimPass())
-      .RegisterPass(CreateAggressiveDCEPass(preserve_interface))
+      .RegisterFixedPointPasses(
+          {scalar_replacement, CreateLocalAccessChainConvertPass,
+           CreateLocalSingleBlockLoadStoreElimPass,
+           CreateLocalSingleStoreElimPass, adce},
+          kMaxCleanupIterations)
       .RegisterPass(CreateSSARewritePass())
       .RegisterPass(CreateAggressiveDCEPass(preserve_interface))
       .RegisterPass(CreateVectorDCEPass())
@@ -220,11 +246,11 @@ Optimizer& Optimizer::RegisterPerformancePasses(bool preserve_interface) {
       .RegisterPass(CreateCopyPropagateArraysPass())
       .RegisterPass(CreateReduceLoadSizePass())
       .RegisterPass(CreateAggressiveDCEPass(preserve_interface))
-      .RegisterPass(CreateBlockMergePass())
-      .RegisterPass(CreateRedundancyEliminationPass())
-      .RegisterPass(CreateDeadBranchElimPass())
-      .RegisterPass(CreateBlockMergePass())
-      .RegisterPass(CreateSimplificationPass());
+      .RegisterFixedPointPasses(
+          {CreateBlockMergePass, CreateRedundancyEliminationPass,
+           CreateDeadBranchElimPass, CreateBlockMergePass,
+           CreateSimplificationPass},
+          kMaxCleanupIterations);
 }
 
 Optimizer& Optimizer::RegisterPerformancePasses() {
@@ -355,6 +381,16 @@ bool Optimizer::RegisterPassFromFlag(const std::string& flag,
     RegisterPass(CreateFreezeSpecConstantValuePass());
   } else if (pass_name == "inline-entry-points-exhaustive") {
     RegisterPass(CreateInlineExhaustivePass());
+  } else if (pass_name == "inline-entry-points-budget") {
+    int budget = (pass_args.size() > 0) ? atoi(pass_args.c_str()) : 0;
+    if (budget > 0) {
+      RegisterPass(CreateInlineBudgetPass(budget));
+    } else {
+      Error(consumer(), nullptr, {},
+            "--inline-entry-points-budget must have a positive integer "
+            "argument");
+      return false;
+    }
   } else if (pass_name == "inline-entry-points-opaque") {
     RegisterPass(CreateInlineOpaquePass());
   } else if (pass_name == "combine-access-chains") {
@@ -372,7 +408,16 @@ bool Optimizer::RegisterPassFromFlag(const std::string& flag,
   } else if (pass_name == "descriptor-array-scalar-replacement") {
     RegisterPass(CreateDescriptorArrayScalarReplacementPass());
   } else if (pass_name == "eliminate-dead-code-aggressive") {
-    RegisterPass(CreateAggressiveDCEPass(preserve_interface));
+    if (pass_args.size() == 0) {
+      RegisterPass(CreateAggressiveDCEPass(preserve_interface));
+    } else if (pass_args == "incremental") {
+      RegisterPass(CreateAggressiveDCEPass(preserve_interface, false, true));
+    } else {
+      Errorf(consumer(), nullptr, {},
+             "Invalid argument for --eliminate-dead-code-aggressive: %s",
+             pass_args.c_str());
+      return false;
+    }
   } else if (pass_name == "eliminate-insert-extract") {
     RegisterPass(CreateInsertExtractElimPass());
   } else if (pass_name == "eliminate-local-single-block") {
@@ -453,6 +498,8 @@ bool Optimizer::RegisterPassFromFlag(const std::string& flag,
         return false;
       }
     }
+  } else if (pass_name == "reduce-register-pressure") {
+    RegisterPass(CreateReduceRegisterPressurePass());
   } else if (pass_name == "redundancy-elimination") {
     RegisterPass(CreateRedundancyEliminationPass());
   } else if (pass_name == "private-to-local") {
@@ -510,6 +557,20 @@ bool Optimizer::RegisterPassFromFlag(const std::string& flag,
             "--loop-unroll-partial must have a positive integer argument");
       return false;
     }
+  } else if (pass_name == "loop-unroll-auto") {
+    if (pass_args.size() == 0) {
+      RegisterPass(CreateLoopAutoUnrollPass());
+    } else {
+      int budget = atoi(pass_args.c_str());
+      if (budget > 0) {
+        RegisterPass(CreateLoopAutoUnrollPass(static_cast<size_t>(budget)));
+      } else {
+        Error(consumer(), nullptr, {},
+              "--loop-unroll-auto must have no argument or a positive "
+              "integer argument");
+        return false;
+      }
+    }
   } else if (pass_name == "loop-peeling") {
     RegisterPass(CreateLoopPeelingPass());
   } else if (pass_name == "loop-peeling-threshold") {
@@ -699,6 +760,7 @@ bool Optimizer::Run(const uint32_t* original_binary,
   context->set_max_id_bound(opt_options->max_id_bound_);
   context->set_preserve_bindings(opt_options->preserve_bindings_);
   context->set_preserve_spec_constants(opt_options->preserve_spec_constants_);
+  context->set_skip_unchanged_functions(opt_options->skip_unchanged_functions_);
 
   impl_->pass_manager.SetValidatorOptions(&opt_options->val_options_);
   impl_->pass_manager.SetTargetEnv(impl_->target_env);
@@ -749,16 +811,36 @@ Optimizer& Optimizer::SetPrintAll(std::ostream* out) {
   return *this;
 }
 
+Optimizer& Optimizer::SetPrintChanged(std::ostream* out) {
+  impl_->pass_manager.SetPrintChanged(out);
+  return *this;
+}
+
 Optimizer& Optimizer::SetTimeReport(std::ostream* out) {
   impl_->pass_manager.SetTimeReport(out);
   return *this;
 }
 
+Optimizer& Optimizer::SetPassReportCallback(PassReportCallback callback) {
+  impl_->pass_manager.SetPassReportCallback(std::move(callback));
+  return *this;
+}
+
+Optimizer& Optimizer::SetPassStatistics(std::ostream* out) {
+  impl_->pass_manager.SetPassStatistics(out);
+  return *this;
+}
+
 Optimizer& Optimizer::SetValidateAfterAll(bool validate) {
   impl_->pass_manager.SetValidateAfterAll(validate);
   return *this;
 }
 
+Optimizer& Optimizer::SetSkipValidationOfUnchangedModule(bool skip) {
+  impl_->pass_manager.SetSkipValidationOfUnchangedModule(skip);
+  return *this;
+}
+
 Optimizer::PassToken CreateNullPass() {
   return MakeUnique<Optimizer::PassToken::Impl>(MakeUnique<opt::NullPass>());
 }
@@ -844,6 +926,11 @@ Optimizer::PassToken CreateInlineExhaustivePass() {
       MakeUnique<opt::InlineExhaustivePass>());
 }
 
+Optimizer::PassToken CreateInlineBudgetPass(uint32_t inline_budget) {
+  return MakeUnique<Optimizer::PassToken::Impl>(
+      MakeUnique<opt::InlineExhaustivePass>(inline_budget));
+}
+
 Optimizer::PassToken CreateInlineOpaquePass() {
   return MakeUnique<Optimizer::PassToken::Impl>(
       MakeUnique<opt::InlineOpaquePass>());
@@ -900,6 +987,14 @@ Optimizer::PassToken CreateAggressiveDCEPass(bool preserve_interface,
       MakeUnique<opt::AggressiveDCEPass>(preserve_interface, remove_outputs));
 }
 
+Optimizer::PassToken CreateAggressiveDCEPass(bool preserve_interface,
+                                             bool remove_outputs,
+                                             bool incremental) {
+  return MakeUnique<Optimizer::PassToken::Impl>(
+      MakeUnique<opt::AggressiveDCEPass>(preserve_interface, remove_outputs,
+                                         incremental));
+}
+
 Optimizer::PassToken CreateRemoveUnusedInterfaceVariablesPass() {
   return MakeUnique<Optimizer::PassToken::Impl>(
       MakeUnique<opt::RemoveUnusedInterfaceVariablesPass>());
@@ -1019,6 +1114,12 @@ Optimizer::PassToken CreateLoopUnrollPass(bool fully_unroll, int factor) {
       MakeUnique<opt::LoopUnroller>(fully_unroll, factor));
 }
 
+Optimizer::PassToken CreateLoopAutoUnrollPass(size_t instruction_budget,
+                                              size_t max_registers) {
+  return MakeUnique<Optimizer::PassToken::Impl>(MakeUnique<opt::LoopUnroller>(
+      opt::LoopUnroller::AutoUnrollLimits{instruction_budget, max_registers}));
+}
+
 Optimizer::PassToken CreateSSARewritePass() {
   return MakeUnique<Optimizer::PassToken::Impl>(
       MakeUnique<opt::SSARewritePass>());
@@ -1039,6 +1140,11 @@ Optimizer::PassToken CreateReduceLoadSizePass(
       MakeUnique<opt::ReduceLoadSize>(load_replacement_threshold));
 }
 
+Optimizer::PassToken CreateReduceRegisterPressurePass() {
+  return MakeUnique<Optimizer::PassToken::Impl>(
+      MakeUnique<opt::ReduceRegisterPressurePass>());
+}
+
 Optimizer::PassToken CreateCombineAccessChainsPass() {
   return MakeUnique<Optimizer::PassToken::Impl>(
       MakeUnique<opt::CombineAccessChains>());
@@ -25,7 +25,12 @@ namespace {
 constexpr uint32_t kTypePointerTypeIdInIdx = 1;
 }  // namespace
 
-Pass::Pass() : consumer_(nullptr), context_(nullptr), already_run_(false) {}
+Pass::Pass()
+    : consumer_(nullptr),
+      context_(nullptr),
+      already_run_(false),
+      force_incremental_(false),
+      last_epoch_(0) {}
 
 Pass::Status Pass::Run(IRContext* ctx) {
   if (already_run_) {
@@ -33,12 +38,25 @@ Pass::Status Pass::Run(IRContext* ctx) {
   }
   already_run_ = true;
 
+  const bool incremental =
+      SupportsIncrementalProcessing() &&
+      (force_incremental_ || ctx->skip_unchanged_functions());
+  if (incremental) {
+    ctx->EnableModificationTracking();
+    last_epoch_ = ctx->GetPassEpoch(GetEpochKey());
+  }
+
   context_ = ctx;
   Pass::Status status = Process();
   context_ = nullptr;
 
+  if (incremental && status != Status::Failure) {
+    ctx->RecordPassEpoch(GetEpochKey());
+  }
+
   if (status == Status::SuccessWithChange) {
     ctx->InvalidateAnalysesExceptFor(GetPreservedAnalyses());
+    if (!ReportsModifiedFunctions()) ctx->MarkAllFunctionsModified();
   }
   if (!(status == Status::Failure || ctx->IsConsistent()))
     assert(false && "An analysis in the context is out of date.");
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -110,6 +111,26 @@ class Pass {
     return IRContext::kAnalysisNone;
   }
 
+  // Returns true if the pass calls |IRContext::MarkFunctionModified| for every
+  // function it changes, either directly or by returning true for it from
+  // |IRContext::ProcessReachableCallTree| and the like.  If it returns false, a
+  // change reported by the pass marks every function as modified.
+  virtual bool ReportsModifiedFunctions() const { return false; }
+
+  // Returns true if the pass can skip functions that have not been modified
+  // since it last ran.  Such a pass must reach a fixed point on every function
+  // it processes, and must report the functions it modifies.
+  virtual bool SupportsIncrementalProcessing() const { return false; }
+
+  // Returns the key used to record when the pass last ran.  Passes whose
+  // results depend on their options must include those options in the key.
+  virtual std::string GetEpochKey() const { return name(); }
+
+  // Requests incremental processing for this pass even if the context does
+  // not skip unchanged functions.  Has no effect if the pass does not support
+  // incremental processing.
+  void SetIncremental(bool incremental) { force_incremental_ = incremental; }
+
   // Return type id for |ptrInst|'s pointee
   uint32_t GetPointeeTypeId(const Instruction* ptrInst) const;
 
@@ -136,6 +157,13 @@ class Pass {
   // successful to indicate whether changes are made to the module.
   virtual Status Process() = 0;
 
+  // Returns true if this run of the pass is incremental and |func| has not
+  // been modified since the last incremental run of the pass.  Such functions
+  // do not need to be processed again.
+  bool IsFunctionUnchanged(const Function* func) const {
+    return last_epoch_ != 0 && context_->GetFunctionEpoch(func) <= last_epoch_;
+  }
+
   // Return the next available SSA id and increment it.
   // TODO(1841): Handle id overflow.
   uint32_t TakeNextId() { return context_->TakeNextId(); }
@@ -157,6 +185,13 @@ class Pass {
   // enforce proper resetting of internal state for each instance.  This member
   // is used to check that we do not run the same instance twice.
   bool already_run_;
+
+  // True if the pass should run incrementally regardless of the context.
+  bool force_incremental_;
+
+  // The epoch at which the last incremental run of this pass finished, or 0 if
+  // this run is not incremental.
+  uint32_t last_epoch_;
 };
 
 inline Pass::Status CombineStatus(Pass::Status a, Pass::Status b) {
@@ -14,80 +14,466 @@
 
 #include "source/opt/pass_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 
 #include "source/opt/ir_context.h"
+#include "source/util/make_unique.h"
 #include "source/util/timer.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
 
 namespace opt {
+namespace {
+
+// The number of words in the header of a SPIR-V binary.
+constexpr size_t kHeaderWordCount = 5;
+
+#if !defined(NDEBUG) || defined(SPIRV_CHECK_CONTEXT)
+// Returns true if the binaries |a| and |b| encode the same instructions.  The
+// headers are not compared, since a pass may take ids without using them.
+bool SameInstructions(const std::vector<uint32_t>& a,
+                      const std::vector<uint32_t>& b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin() + kHeaderWordCount, a.end(),
+                    b.begin() + kHeaderWordCount);
+}
+#endif
+
+// Removes from |binary| the instructions of the functions whose result ids
+// are not in |keep|.
+void RemoveFunctions(const std::unordered_set<uint32_t>& keep,
+                     std::vector<uint32_t>* binary) {
+  size_t out = kHeaderWordCount;
+  bool in_function = false;
+  bool keep_function = false;
+  for (size_t i = kHeaderWordCount; i < binary->size();) {
+    const uint32_t word_count = (*binary)[i] >> 16;
+    const auto opcode = static_cast<spv::Op>((*binary)[i] & 0xFFFF);
+    if (word_count == 0 || i + word_count > binary->size()) break;
+    if (opcode == spv::Op::OpFunction) {
+      in_function = true;
+      keep_function = word_count > 2 && keep.count((*binary)[i + 2]) != 0;
+    }
+    if (!in_function || keep_function) {
+      std::copy(binary->begin() + i, binary->begin() + i + word_count,
+                binary->begin() + out);
+      out += word_count;
+    }
+    if (opcode == spv::Op::OpFunctionEnd) in_function = false;
+    i += word_count;
+  }
+  binary->resize(out);
+}
+
+// Splits the disassembly |text| of a module into the text of the global
+// declarations, appended to |*globals|, and the text of each function, in
+// order, appended to |*functions|.
+void SplitDisassembly(const std::string& text, std::string* globals,
+                      std::vector<std::string>* functions) {
+  std::string* current = globals;
+  for (size_t begin = 0; begin < text.size();) {
+    size_t end = text.find('\n', begin);
+    end = end == std::string::npos ? text.size() : end + 1;
+    const std::string_view line(text.data() + begin, end - begin);
+    const size_t assign = line.find(" = ");
+    if (assign != std::string_view::npos &&
+        line.substr(assign).rfind(" = OpFunction ", 0) == 0) {
+      functions->emplace_back();
+      current = &functions->back();
+    }
+    current->append(line);
+    const size_t first = line.find_first_not_of(' ');
+    if (first != std::string_view::npos &&
+        line.substr(first).rfind("OpFunctionEnd", 0) == 0) {
+      current = globals;
+    }
+    begin = end;
+  }
+}
+
+// The name of each analysis reported in PassReport::invalidated_analyses.
+struct AnalysisName {
+  IRContext::Analysis analysis;
+  const char* name;
+};
+
+constexpr AnalysisName kAnalysisNames[] = {
+    {IRContext::kAnalysisDefUse, "DefUse"},
+    {IRContext::kAnalysisInstrToBlockMapping, "InstrToBlockMapping"},
+    {IRContext::kAnalysisDecorations, "Decorations"},
+    {IRContext::kAnalysisCombinators, "Combinators"},
+    {IRContext::kAnalysisCFG, "CFG"},
+    {IRContext::kAnalysisDominatorAnalysis, "DominatorAnalysis"},
+    {IRContext::kAnalysisLoopAnalysis, "LoopAnalysis"},
+    {IRContext::kAnalysisNameMap, "NameMap"},
+    {IRContext::kAnalysisScalarEvolution, "ScalarEvolution"},
+    {IRContext::kAnalysisRegisterPressure, "RegisterPressure"},
+    {IRContext::kAnalysisValueNumberTable, "ValueNumberTable"},
+    {IRContext::kAnalysisStructuredCFG, "StructuredCFG"},
+    {IRContext::kAnalysisBuiltinVarId, "BuiltinVarId"},
+    {IRContext::kAnalysisIdToFuncMapping, "IdToFuncMapping"},
+    {IRContext::kAnalysisConstants, "Constants"},
+    {IRContext::kAnalysisTypes, "Types"},
+    {IRContext::kAnalysisDebugInfo, "DebugInfo"},
+    {IRContext::kAnalysisLiveness, "Liveness"},
+    {IRContext::kAnalysisIdToGraphMapping, "IdToGraphMapping"},
+};
+
+// Returns a mask of the analyses in |kAnalysisNames| that are valid in
+// |context|.
+uint32_t ValidAnalyses(IRContext* context) {
+  uint32_t valid = 0;
+  for (const AnalysisName& entry : kAnalysisNames) {
+    if (context->AreAnalysesValid(entry.analysis)) valid |= entry.analysis;
+  }
+  return valid;
+}
+
+// Sets |*instructions| and |*words| to the number of instructions and words
+// in the module of |context|, including debug line instructions and the
+// header.
+void CountModule(IRContext* context, size_t* instructions, size_t* words) {
+  size_t num_instructions = 0;
+  size_t num_words = kHeaderWordCount;
+  context->module()->ForEachInst(
+      [&num_instructions, &num_words](Instruction* inst) {
+        ++num_instructions;
+        num_words += 1 + inst->NumOperandWords();
+      },
+      /* run_on_debug_line_insts = */ true);
+  *instructions = num_instructions;
+  *words = num_words;
+}
+
+}  // namespace
 
 Pass::Status PassManager::Run(IRContext* context) {
   auto status = Pass::Status::SuccessWithoutChange;
 
-  // If print_all_stream_ is not null, prints the disassembly of the module
-  // to that stream, with the given preamble and optionally the pass name.
-  auto print_disassembly = [&context, this](const char* preamble, Pass* pass) {
-    if (print_all_stream_) {
-      std::vector<uint32_t> binary;
-      context->module()->ToBinary(&binary, false);
-      SpirvTools t(target_env_);
-      t.SetMessageConsumer(consumer());
-      std::string disassembly;
-      std::string pass_name = (pass ? pass->name() : "");
-      if (!t.Disassemble(binary, &disassembly)) {
-        std::string msg = "Disassembly failed before pass ";
-        msg += pass_name + "\n";
-        spv_position_t null_pos{0, 0, 0};
-        consumer()(SPV_MSG_WARNING, "", null_pos, msg.c_str());
-        return;
-      }
-      *print_all_stream_ << preamble << pass_name << "\n"
-                         << disassembly << std::endl;
-    }
-  };
+  if (validate_after_all_) {
+    validator_ = MakeUnique<SpirvTools>(target_env_);
+    validator_->SetMessageConsumer(consumer());
+    ResetValidated();
+  }
+
+  if (print_changed_stream_) {
+    context->EnableModificationTracking();
+    PrintChanged(nullptr, 0, context);
+  }
 
   SPIRV_TIMER_DESCRIPTION(time_report_stream_, /* measure_mem_usage = */ true);
-  for (auto& pass : passes_) {
-    print_disassembly("; IR before pass ", pass.get());
-    SPIRV_TIMER_SCOPED(time_report_stream_, (pass ? pass->name() : ""), true);
-    const auto one_status = pass->Run(context);
+  size_t next_group = 0;
+  for (size_t i = 0; i < passes_.size();) {
+    Pass::Status one_status;
+    if (next_group < groups_.size() && groups_[next_group].begin == i) {
+      const FixedPointGroup& group = groups_[next_group++];
+      one_status = RunFixedPointGroup(group, context);
+      i += group.factories.size();
+    } else {
+      one_status = RunPass(passes_[i].get(), context);
+      // Reset the pass to free any memory used by the pass.
+      passes_[i].reset(nullptr);
+      ++i;
+    }
     if (one_status == Pass::Status::Failure) return one_status;
     if (one_status == Pass::Status::SuccessWithChange) status = one_status;
+  }
+  PrintDisassembly("; IR after last pass", nullptr, context);
+  PrintStatistics();
 
-    if (validate_after_all_) {
-      spvtools::SpirvTools tools(target_env_);
-      tools.SetMessageConsumer(consumer());
-      std::vector<uint32_t> binary;
-      context->module()->ToBinary(&binary, true);
-      if (!tools.Validate(binary.data(), binary.size(), val_options_)) {
-        std::string msg = "Validation failed after pass ";
-        msg += pass->name();
-        spv_position_t null_pos{0, 0, 0};
-        consumer()(SPV_MSG_INTERNAL_ERROR, "", null_pos, msg.c_str());
-        return Pass::Status::Failure;
-      }
+  // Set the Id bound in the header in case a pass forgot to do so.  The
+  // context tracks the highest defined id, so this does not rescan the module
+  // when the def-use analysis is valid.
+  if (status == Pass::Status::SuccessWithChange) {
+    context->module()->SetIdBound(context->ComputeIdBound());
+  }
+  passes_.clear();
+  groups_.clear();
+  statistics_.clear();
+  printed_globals_.clear();
+  printed_functions_.clear();
+  validator_.reset();
+  ResetValidated();
+  return status;
+}
+
+Pass::Status PassManager::RunPass(Pass* pass, IRContext* context) {
+  PrintDisassembly("; IR before pass ", pass, context);
+  const uint32_t epoch = context->current_epoch();
+  SPIRV_TIMER_SCOPED(time_report_stream_, (pass ? pass->name() : ""), true);
+  const auto status = pass_report_callback_ ? RunPassWithReport(pass, context)
+                                            : pass->Run(context);
+  if (status == Pass::Status::Failure) return status;
+  if (print_changed_stream_ && status == Pass::Status::SuccessWithChange) {
+    PrintChanged(pass, epoch, context);
+  }
+
+  PassStatistics& stats = statistics_[pass->name()];
+  ++stats.runs;
+  if (status == Pass::Status::SuccessWithChange) ++stats.useful_runs;
+
+  if (validate_after_all_ && !ValidateAfterPass(pass, status, context)) {
+    return Pass::Status::Failure;
+  }
+  return status;
+}
+
+Pass::Status PassManager::RunPassWithReport(Pass* pass, IRContext* context) {
+  PassReport report;
+  report.name = pass->name();
+  CountModule(context, &report.instructions_before, &report.words_before);
+  const uint32_t valid_before = ValidAnalyses(context);
+
+#if defined(SPIRV_TIMER_ENABLED)
+  utils::Timer timer(nullptr, /* measure_mem_usage = */ true);
+  timer.Start();
+  const auto status = pass->Run(context);
+  timer.Stop();
+  report.wall_time = timer.WallTime();
+  report.cpu_time = timer.CPUTime();
+  report.rss_delta = timer.RSS();
+#else
+  // Without timer support, fall back to the portable clocks.  The RSS delta
+  // is not available.
+  const auto wall_start = std::chrono::steady_clock::now();
+  const std::clock_t cpu_start = std::clock();
+  const auto status = pass->Run(context);
+  const std::clock_t cpu_end = std::clock();
+  report.wall_time = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - wall_start)
+                         .count();
+  if (cpu_start != std::clock_t(-1) && cpu_end != std::clock_t(-1)) {
+    report.cpu_time = static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+  }
+#endif
+  // The module may be in an inconsistent state after a failure.
+  if (status == Pass::Status::Failure) return status;
+
+  report.changed = status == Pass::Status::SuccessWithChange;
+  CountModule(context, &report.instructions_after, &report.words_after);
+  const uint32_t valid_after = ValidAnalyses(context);
+  for (const AnalysisName& entry : kAnalysisNames) {
+    if ((valid_before & entry.analysis) && !(valid_after & entry.analysis)) {
+      report.invalidated_analyses.push_back(entry.name);
     }
+  }
+  pass_report_callback_(report);
+  return status;
+}
+
+bool PassManager::ValidateAfterPass(Pass* pass, Pass::Status status,
+                                    IRContext* context) {
+  // If requested, a pass that reports no change is trusted not to have made
+  // the module invalid, so validating again is only needed if the module has
+  // not been validated yet.  Debug builds still serialize the module to check
+  // that the pass really did not change it, which is much cheaper than
+  // validating it.
+  const bool unchanged = skip_validation_of_unchanged_module_ &&
+                         status == Pass::Status::SuccessWithoutChange &&
+                         validated_;
+#if defined(NDEBUG) && !defined(SPIRV_CHECK_CONTEXT)
+  if (unchanged) return true;
+#endif
 
-    // Reset the pass to free any memory used by the pass.
-    pass.reset(nullptr);
+  std::vector<uint32_t> binary;
+  context->module()->ToBinary(&binary, true);
+#if !defined(NDEBUG) || defined(SPIRV_CHECK_CONTEXT)
+  if (unchanged) {
+    if (SameInstructions(binary, validated_binary_)) return true;
+    std::string msg = "Pass ";
+    msg += pass->name();
+    msg += " reported no change but modified the module";
+    spv_position_t null_pos{0, 0, 0};
+    consumer()(SPV_MSG_WARNING, "", null_pos, msg.c_str());
   }
-  print_disassembly("; IR after last pass", nullptr);
+#endif
 
-  // Set the Id bound in the header in case a pass forgot to do so.
-  //
-  // TODO(dnovillo): This should be unnecessary and automatically maintained by
-  // the IRContext.
-  if (status == Pass::Status::SuccessWithChange) {
-    context->module()->SetIdBound(context->module()->ComputeIdBound());
+  if (!validator_->Validate(binary.data(), binary.size(), val_options_)) {
+    std::string msg = "Validation failed after pass ";
+    msg += pass->name();
+    spv_position_t null_pos{0, 0, 0};
+    consumer()(SPV_MSG_INTERNAL_ERROR, "", null_pos, msg.c_str());
+    return false;
+  }
+  validated_ = true;
+#if !defined(NDEBUG) || defined(SPIRV_CHECK_CONTEXT)
+  if (skip_validation_of_unchanged_module_) {
+    validated_binary_ = std::move(binary);
+  }
+#endif
+  return true;
+}
+
+void PassManager::ResetValidated() {
+  validated_ = false;
+  validated_binary_.clear();
+}
+
+Pass::Status PassManager::RunFixedPointGroup(const FixedPointGroup& group,
+                                             IRContext* context) {
+  auto status = Pass::Status::SuccessWithoutChange;
+  const size_t num_passes = group.factories.size();
+
+  // The names of the passes, which outlive the instances that ran.
+  std::vector<std::string> names;
+  names.reserve(num_passes);
+  for (size_t k = 0; k < num_passes; ++k) {
+    names.push_back(passes_[group.begin + k]->name());
+  }
+
+  // Passes are deterministic, so a pass that made no change cannot make one
+  // until another pass changes the module.  |num_changes| counts the runs in
+  // the group that changed the module, and |unchanged_at[k]| holds its value
+  // when the |k|th pass last ran without change.
+  constexpr uint32_t kNeverUnchanged = 0xFFFFFFFF;
+  uint32_t num_changes = 0;
+  std::vector<uint32_t> unchanged_at(num_passes, kNeverUnchanged);
+
+  for (uint32_t iteration = 0; iteration < group.max_iterations; ++iteration) {
+    bool changed = false;
+    for (size_t k = 0; k < num_passes; ++k) {
+      std::unique_ptr<Pass>& first_instance = passes_[group.begin + k];
+      if (unchanged_at[k] == num_changes) {
+        ++statistics_[names[k]].skipped_runs;
+        first_instance.reset(nullptr);
+        continue;
+      }
+
+      std::unique_ptr<Pass> pass;
+      if (first_instance) {
+        pass = std::move(first_instance);
+      } else {
+        pass = group.factories[k]();
+        pass->SetMessageConsumer(consumer_);
+      }
+
+      const auto one_status = RunPass(pass.get(), context);
+      if (one_status == Pass::Status::Failure) return one_status;
+      if (one_status == Pass::Status::SuccessWithChange) {
+        status = one_status;
+        changed = true;
+        ++num_changes;
+      } else {
+        unchanged_at[k] = num_changes;
+      }
+    }
+    if (!changed) break;
+  }
+
+  // Free any first-iteration instances that never ran.
+  for (size_t k = 0; k < num_passes; ++k) {
+    passes_[group.begin + k].reset(nullptr);
   }
-  passes_.clear();
   return status;
 }
 
+void PassManager::PrintDisassembly(const char* preamble, Pass* pass,
+                                   IRContext* context) {
+  if (print_all_stream_) {
+    std::vector<uint32_t> binary;
+    context->module()->ToBinary(&binary, false);
+    SpirvTools t(target_env_);
+    t.SetMessageConsumer(consumer());
+    std::string disassembly;
+    std::string pass_name = (pass ? pass->name() : "");
+    if (!t.Disassemble(binary, &disassembly)) {
+      std::string msg = "Disassembly failed before pass ";
+      msg += pass_name + "\n";
+      spv_position_t null_pos{0, 0, 0};
+      consumer()(SPV_MSG_WARNING, "", null_pos, msg.c_str());
+      return;
+    }
+    *print_all_stream_ << preamble << pass_name << "\n"
+                       << disassembly << std::endl;
+  }
+}
+
+void PassManager::PrintChanged(Pass* pass, uint32_t epoch,
+                               IRContext* context) {
+  // Only the functions that the context tracked as modified during the pass
+  // are disassembled.  The global declarations are always disassembled, since
+  // their changes are not tracked.
+  std::vector<uint32_t> function_ids;
+  std::unordered_set<uint32_t> live_functions;
+  for (Function& func : *context->module()) {
+    live_functions.insert(func.result_id());
+    if (pass == nullptr || context->GetFunctionEpoch(&func) > epoch) {
+      function_ids.push_back(func.result_id());
+    }
+  }
+
+  std::vector<uint32_t> binary;
+  context->module()->ToBinary(&binary, false);
+  if (function_ids.size() != live_functions.size()) {
+    const std::unordered_set<uint32_t> keep(function_ids.begin(),
+                                            function_ids.end());
+    RemoveFunctions(keep, &binary);
+  }
+  SpirvTools t(target_env_);
+  t.SetMessageConsumer(consumer());
+  std::string disassembly;
+  const std::string pass_name = (pass ? pass->name() : "");
+  if (!t.Disassemble(binary, &disassembly)) {
+    std::string msg = "Disassembly failed after pass ";
+    msg += pass_name + "\n";
+    spv_position_t null_pos{0, 0, 0};
+    consumer()(SPV_MSG_WARNING, "", null_pos, msg.c_str());
+    return;
+  }
+
+  std::string globals;
+  std::vector<std::string> functions;
+  SplitDisassembly(disassembly, &globals, &functions);
+  std::ostream& out = *print_changed_stream_;
+  if (pass == nullptr) out << "; IR before first pass\n" << disassembly;
+
+  if (globals != printed_globals_) {
+    if (pass) {
+      out << "; IR after pass " << pass_name << ": global declarations\n"
+          << globals;
+    }
+    printed_globals_ = std::move(globals);
+  }
+  for (size_t i = 0; i < functions.size() && i < function_ids.size(); ++i) {
+    std::string& printed = printed_functions_[function_ids[i]];
+    if (functions[i] == printed) continue;
+    if (pass) {
+      out << "; IR after pass " << pass_name << ": function\n"
+          << functions[i];
+    }
+    printed = std::move(functions[i]);
+  }
+  for (auto it = printed_functions_.begin(); it != printed_functions_.end();) {
+    if (live_functions.count(it->first)) {
+      ++it;
+      continue;
+    }
+    out << "; IR after pass " << pass_name << ": removed function "
+        << it->second.substr(0, it->second.find(" = ")) << "\n";
+    it = printed_functions_.erase(it);
+  }
+  out.flush();
+}
+
+void PassManager::PrintStatistics() const {
+  if (!statistics_stream_) return;
+  *statistics_stream_ << "Pass statistics (runs, useful runs, skipped runs):\n";
+  for (const auto& entry : statistics_) {
+    const PassStatistics& stats = entry.second;
+    *statistics_stream_ << "  " << entry.first << ": " << stats.runs << ", "
+                        << stats.useful_runs << ", " << stats.skipped_runs
+                        << "\n";
+  }
+  statistics_stream_->flush();
+}
+
 }  // namespace opt
 }  // namespace spvtools
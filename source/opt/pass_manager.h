@@ -15,8 +15,12 @@
 #ifndef SOURCE_OPT_PASS_MANAGER_H_
 #define SOURCE_OPT_PASS_MANAGER_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -26,6 +30,7 @@
 
 #include "source/opt/ir_context.h"
 #include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/optimizer.hpp"
 
 namespace spvtools {
 namespace opt {
@@ -35,6 +40,10 @@ namespace opt {
 // to run on a module. Passes are executed in the exact order of addition.
 class PassManager {
  public:
+  // Creates a new instance of a pass.  A pass instance can only be run once,
+  // so passes that may run repeatedly are added through factories.
+  using PassFactory = std::function<std::unique_ptr<Pass>()>;
+
   // Constructs a pass manager.
   //
   // The constructed instance will have an empty message consumer, which just
@@ -43,10 +52,14 @@ class PassManager {
   PassManager()
       : consumer_(nullptr),
         print_all_stream_(nullptr),
+        print_changed_stream_(nullptr),
         time_report_stream_(nullptr),
         target_env_(SPV_ENV_UNIVERSAL_1_2),
+        statistics_stream_(nullptr),
         val_options_(nullptr),
-        validate_after_all_(false) {}
+        validate_after_all_(false),
+        skip_validation_of_unchanged_module_(false),
+        validated_(false) {}
 
   // Sets the message consumer to the given |consumer|.
   void SetMessageConsumer(MessageConsumer c) { consumer_ = std::move(c); }
@@ -59,6 +72,17 @@ class PassManager {
   template <typename T, typename... Args>
   void AddPass(Args&&... args);
 
+  // Adds a group of passes created by |factories| that is run in order,
+  // repeatedly, until an iteration over the group makes no change to the
+  // module or |max_iterations| iterations have run.  Within the group, a pass
+  // is not run again if no pass has changed the module since it last ran
+  // without making a change.
+  //
+  // The instances used for the first iteration are counted by NumPasses() and
+  // can be accessed through GetPass().
+  void AddFixedPointGroup(std::vector<PassFactory> factories,
+                          uint32_t max_iterations);
+
   // Returns the number of passes added.
   uint32_t NumPasses() const;
   // Returns a pointer to the |index|th pass added.
@@ -84,6 +108,15 @@ class PassManager {
     return *this;
   }
 
+  // Sets the option to print the disassembly of the module before the first
+  // pass and then, after each pass that changed the module, only the global
+  // declarations and functions whose disassembly changed.  Output is written
+  // to |out| if that is not null.  No output is generated if |out| is null.
+  PassManager& SetPrintChanged(std::ostream* out) {
+    print_changed_stream_ = out;
+    return *this;
+  }
+
   // Sets the option to print the resource utilization of each pass. Output is
   // written to |out| if that is not null. No output is generated if |out| is
   // null.
@@ -92,6 +125,22 @@ class PassManager {
     return *this;
   }
 
+  // Sets a |callback| that receives a PassReport after each pass runs.  No
+  // reports are made if |callback| is empty.
+  PassManager& SetPassReportCallback(PassReportCallback callback) {
+    pass_report_callback_ = std::move(callback);
+    return *this;
+  }
+
+  // Sets the option to print, for each pass, how many times it ran, how many
+  // of those runs changed the module, and how many times it was skipped in a
+  // fixed-point group.  Output is written to |out| if that is not null.  No
+  // output is generated if |out| is null.
+  PassManager& SetPassStatistics(std::ostream* out) {
+    statistics_stream_ = out;
+    return *this;
+  }
+
   // Sets the target environment for validation.
   PassManager& SetTargetEnv(spv_target_env env) {
     target_env_ = env;
@@ -110,23 +159,115 @@ class PassManager {
     return *this;
   }
 
+  // Sets the option to skip the validation after a pass that reports that it
+  // did not change the module, once the module has been validated during the
+  // run.  Only has an effect when validating after each pass.  A pass that
+  // wrongly reports no change is then not caught, and its output is blamed on
+  // the next pass that changes the module.
+  PassManager& SetSkipValidationOfUnchangedModule(bool skip) {
+    skip_validation_of_unchanged_module_ = skip;
+    return *this;
+  }
+
  private:
+  // A range of |passes_| that is run to a fixed point.  See
+  // AddFixedPointGroup().
+  struct FixedPointGroup {
+    // The index of the first pass of the group in |passes_|.
+    size_t begin;
+    // Creates the passes of the group for the second and later iterations.
+    std::vector<PassFactory> factories;
+    // The maximum number of iterations over the group.
+    uint32_t max_iterations;
+  };
+
+  // The number of times a pass ran, how many of those runs changed the
+  // module, and how many times the pass was skipped because it could not
+  // have made a change.
+  struct PassStatistics {
+    uint32_t runs = 0;
+    uint32_t useful_runs = 0;
+    uint32_t skipped_runs = 0;
+  };
+
+  // Runs |pass| on |context|, printing the disassembly, measuring resource
+  // utilization and validating as requested.
+  Pass::Status RunPass(Pass* pass, IRContext* context);
+
+  // Runs |pass| on |context| as RunPass() does, and sends a PassReport of
+  // the run to |pass_report_callback_|.
+  Pass::Status RunPassWithReport(Pass* pass, IRContext* context);
+
+  // Runs the passes of |group| on |context| until they reach a fixed point or
+  // the iteration limit.  The first iteration uses the instances in |passes_|.
+  Pass::Status RunFixedPointGroup(const FixedPointGroup& group,
+                                  IRContext* context);
+
+  // Validates the module in |context| after |pass| has run and returned
+  // |status|.  Returns false if the module is invalid.
+  bool ValidateAfterPass(Pass* pass, Pass::Status status, IRContext* context);
+
+  // Forgets that the module has been validated.
+  void ResetValidated();
+
+  // Prints the disassembly of the module in |context| to |print_all_stream_|
+  // if it is not null, with the given |preamble| and optionally the name of
+  // |pass|.
+  void PrintDisassembly(const char* preamble, Pass* pass, IRContext* context);
+
+  // Prints the parts of the module in |context| that changed since they were
+  // last printed to |print_changed_stream_|, after |pass| has run.  Only the
+  // functions modified after |epoch| are disassembled.  If |pass| is null, the
+  // whole module is printed as the IR before the first pass.
+  void PrintChanged(Pass* pass, uint32_t epoch, IRContext* context);
+
+  // Prints |statistics_| to |statistics_stream_| if it is not null.
+  void PrintStatistics() const;
+
   // Consumer for messages.
   MessageConsumer consumer_;
   // A vector of passes. Order matters.
   std::vector<std::unique_ptr<Pass>> passes_;
+  // The fixed-point groups, ordered by their position in |passes_|.
+  std::vector<FixedPointGroup> groups_;
+  // Run statistics for each pass name, collected by Run().
+  std::map<std::string, PassStatistics> statistics_;
   // The output stream to write disassembly to before each pass, and after
   // the last pass.  If this is null, no output is generated.
   std::ostream* print_all_stream_;
+  // The output stream to write the changed parts of the module to after each
+  // pass.  If this is null, no output is generated.
+  std::ostream* print_changed_stream_;
+  // The disassembly of the global declarations and of each function, by
+  // result id, as last printed to |print_changed_stream_|.
+  std::string printed_globals_;
+  std::unordered_map<uint32_t, std::string> printed_functions_;
   // The output stream to write the resource utilization of each pass. If this
   // is null, no output is generated.
   std::ostream* time_report_stream_;
+  // The callback that receives the report of each pass, or empty if no
+  // reports are requested.
+  PassReportCallback pass_report_callback_;
+  // The output stream to write the run statistics of each pass.  If this is
+  // null, no output is generated.
+  std::ostream* statistics_stream_;
   // The target environment.
   spv_target_env target_env_;
   // The validator options (used when validating each pass).
   spv_validator_options val_options_;
   // Controls whether validation occurs after every pass.
   bool validate_after_all_;
+  // Controls whether validation is skipped after passes that report no change.
+  bool skip_validation_of_unchanged_module_;
+  // The tools used to validate after every pass, created once per run.
+  std::unique_ptr<SpirvTools> validator_;
+  // True if the module has been validated during this run.
+  bool validated_;
+  // The binary of the module that was last validated during this run, when
+  // validation is skipped after passes that report no change.  It is only
+  // filled in builds that check the context, to verify that those passes
+  // really left the module unchanged, and is empty otherwise.
+  std::vector<uint32_t> validated_binary_;
 };
 
 inline void PassManager::AddPass(std::unique_ptr<Pass> pass) {
@@ -139,6 +280,16 @@ inline void PassManager::AddPass(Args&&... args) {
   passes_.back()->SetMessageConsumer(consumer_);
 }
 
+inline void PassManager::AddFixedPointGroup(std::vector<PassFactory> factories,
+                                            uint32_t max_iterations) {
+  const size_t begin = passes_.size();
+  for (const auto& factory : factories) {
+    passes_.push_back(factory());
+    passes_.back()->SetMessageConsumer(consumer_);
+  }
+  groups_.push_back({begin, std::move(factories), max_iterations});
+}
+
 inline uint32_t PassManager::NumPasses() const {
   return static_cast<uint32_t>(passes_.size());
 }
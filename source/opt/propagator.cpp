@@ -14,9 +14,33 @@
 
 #include "source/opt/propagator.h"
 
+#include <algorithm>
+
 namespace spvtools {
 namespace opt {
 
+SSAPropagator::InstructionState& SSAPropagator::GetState(
+    const Instruction* inst) {
+  const uint32_t uid = inst->unique_id();
+  if (uid >= inst_states_.size()) inst_states_.resize(uid + 1);
+  InstructionState& state = inst_states_[uid];
+  if (state.run != run_) {
+    state = InstructionState();
+    state.run = run_;
+  }
+  return state;
+}
+
+uint32_t SSAPropagator::FindEdge(const Edge& edge) const {
+  const uint32_t source = BlockIndex(edge.source);
+  if (source == kNone) return kNone;
+  for (uint32_t i = successor_offsets_[source];
+       i < successor_offsets_[source + 1]; ++i) {
+    if (successors_[i] == edge.dest) return i;
+  }
+  return kNone;
+}
+
 void SSAPropagator::AddControlEdge(const Edge& edge) {
   BasicBlock* dest_bb = edge.dest;
 
@@ -68,18 +92,13 @@ bool SSAPropagator::IsPhiArgExecutable(Instruction* phi, uint32_t i) const {
 }
 
 bool SSAPropagator::SetStatus(Instruction* inst, PropStatus status) {
-  bool has_old_status = false;
-  PropStatus old_status = kVarying;
-  if (HasStatus(inst)) {
-    has_old_status = true;
-    old_status = Status(inst);
-  }
-
-  assert((!has_old_status || old_status <= status) &&
+  InstructionState& state = GetState(inst);
+  assert((!state.has_status || state.status <= status) &&
          "Invalid lattice transition");
 
-  bool status_changed = !has_old_status || (old_status != status);
-  if (status_changed) statuses_[inst] = status;
+  bool status_changed = !state.has_status || (state.status != status);
+  state.has_status = true;
+  state.status = status;
 
   return status_changed;
 }
@@ -111,8 +130,10 @@ Pass::Status SSAPropagator::Simulate(Instruction* instr) {
     // block.
     if (instr->IsBlockTerminator()) {
       BasicBlock* block = ctx_->get_instr_block(instr);
-      for (const auto& e : bb_succs_.at(block)) {
-        AddControlEdge(e);
+      const uint32_t index = BlockIndex(block);
+      for (uint32_t i = successor_offsets_[index];
+           i < successor_offsets_[index + 1]; ++i) {
+        AddControlEdge(Edge(block, successors_[i]));
       }
     }
     return Pass::Status::SuccessWithoutChange;
@@ -214,8 +235,9 @@ Pass::Status SSAPropagator::Simulate(BasicBlock* block) {
 
     // If this block has exactly one successor, mark the edge to its successor
     // as executable.
-    if (bb_succs_.at(block).size() == 1) {
-      AddControlEdge(bb_succs_.at(block).at(0));
+    const uint32_t index = BlockIndex(block);
+    if (successor_offsets_[index + 1] - successor_offsets_[index] == 1) {
+      AddControlEdge(Edge(block, successors_[successor_offsets_[index]]));
     }
   }
 
@@ -224,33 +246,51 @@ Pass::Status SSAPropagator::Simulate(BasicBlock* block) {
 }
 
 void SSAPropagator::Initialize(Function* fn) {
-  // Compute predecessor and successor blocks for every block in |fn|'s CFG.
-  // TODO(dnovillo): Move this to CFG and always build them. Alternately,
-  // move it to IRContext and build CFG preds/succs on-demand.
-  bb_succs_[ctx_->cfg()->pseudo_entry_block()].push_back(
-      Edge(ctx_->cfg()->pseudo_entry_block(), fn->entry().get()));
+  // Start a new run.  This makes the state of earlier runs stale.  If the run
+  // number wraps around, the stale state must be cleared instead.
+  if (++run_ == 0) {
+    inst_states_.clear();
+    block_slots_.clear();
+    run_ = 1;
+  }
+  ssa_edge_uses_ = {};
+  blocks_ = {};
+
+  // Number the blocks of |fn| densely, and size the instruction states for
+  // every instruction in |fn|.
+  uint32_t num_blocks = 0;
+  uint32_t max_uid = 0;
+  const uint32_t id_bound = ctx_->module()->IdBound();
+  if (block_slots_.size() < id_bound) block_slots_.resize(id_bound);
+  for (auto& block : *fn) {
+    BlockSlot& slot = block_slots_[block.id()];
+    slot.run = run_;
+    slot.index = num_blocks++;
+    block.ForEachInst([&max_uid](Instruction* inst) {
+      max_uid = std::max(max_uid, inst->unique_id());
+    });
+  }
+  if (inst_states_.size() <= max_uid) inst_states_.resize(max_uid + 1);
+  simulated_blocks_.assign(num_blocks, false);
 
+  // Compute the successor edges of every block in |fn|'s CFG.
+  successor_offsets_.clear();
+  successors_.clear();
+  successor_offsets_.reserve(num_blocks + 1);
   for (auto& block : *fn) {
+    successor_offsets_.push_back(static_cast<uint32_t>(successors_.size()));
     const auto& const_block = block;
-    const_block.ForEachSuccessorLabel([this, &block](const uint32_t label_id) {
-      BasicBlock* succ_bb =
-          ctx_->get_instr_block(get_def_use_mgr()->GetDef(label_id));
-      bb_succs_[&block].push_back(Edge(&block, succ_bb));
-      bb_preds_[succ_bb].push_back(Edge(succ_bb, &block));
+    const_block.ForEachSuccessorLabel([this](const uint32_t label_id) {
+      successors_.push_back(
+          ctx_->get_instr_block(get_def_use_mgr()->GetDef(label_id)));
     });
-    if (block.IsReturnOrAbort()) {
-      bb_succs_[&block].push_back(
-          Edge(&block, ctx_->cfg()->pseudo_exit_block()));
-      bb_preds_[ctx_->cfg()->pseudo_exit_block()].push_back(
-          Edge(ctx_->cfg()->pseudo_exit_block(), &block));
-    }
   }
+  successor_offsets_.push_back(static_cast<uint32_t>(successors_.size()));
+  executable_edges_.assign(successors_.size(), false);
 
-  // Add the edges out of the entry block to seed the propagator.
-  const auto& entry_succs = bb_succs_[ctx_->cfg()->pseudo_entry_block()];
-  for (const auto& e : entry_succs) {
-    AddControlEdge(e);
-  }
+  // The edge from the pseudo entry block is the only way into the entry
+  // block, so the entry block seeds the propagator.
+  blocks_.push(fn->entry().get());
 }
 
 bool SSAPropagator::Run(Function* fn) {
@@ -17,9 +17,6 @@
 
 #include <functional>
 #include <queue>
-#include <set>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -188,12 +185,15 @@ class SSAPropagator {
   using VisitFunction = std::function<PropStatus(Instruction*, BasicBlock**)>;
 
   SSAPropagator(IRContext* context, const VisitFunction& visit_fn)
-      : ctx_(context), visit_fn_(visit_fn) {}
+      : ctx_(context), visit_fn_(visit_fn), run_(0) {}
 
   // Runs the propagator on function |fn|. Returns true if changes were made to
   // the function. Otherwise, it returns false. The user should check
   // IRContext::id_overflow() to see if there was an error caused by reaching
   // the max id.
+  //
+  // The propagator may be run on several functions in turn.  The state of a
+  // run is discarded when the next run starts.
   bool Run(Function* fn);
 
   // Returns true if the |i|th argument for |phi| comes through a CFG edge that
@@ -203,12 +203,15 @@ class SSAPropagator {
 
   // Returns true if |inst| has a recorded status. This will be true once |inst|
   // has been simulated once.
-  bool HasStatus(Instruction* inst) const { return statuses_.count(inst); }
+  bool HasStatus(Instruction* inst) const {
+    const InstructionState* state = FindState(inst);
+    return state && state->has_status;
+  }
 
   // Returns the current propagation status of |inst|. Assumes
   // |HasStatus(inst)| returns true.
   PropStatus Status(Instruction* inst) const {
-    return statuses_.find(inst)->second;
+    return FindState(inst)->status;
   }
 
   // Records the propagation status |status| for |inst|. Returns true if the
@@ -216,6 +219,31 @@ class SSAPropagator {
   bool SetStatus(Instruction* inst, PropStatus status);
 
  private:
+  // The propagation state of an instruction.  States are stored densely by
+  // Instruction::unique_id(), and a state whose |run| is not the current run
+  // is stale and treated as empty, so that the table is not cleared between
+  // runs.
+  struct InstructionState {
+    uint32_t run = 0;
+    bool has_status = false;
+    // True if the instruction should not be simulated again because it has
+    // been found to be in the kVarying state.
+    bool do_not_simulate = false;
+    PropStatus status = kNotInteresting;
+  };
+
+  // The dense index of a block of the function being propagated, stored by
+  // the block's label id.  As for InstructionState, an entry whose |run| is
+  // not the current run is stale.
+  struct BlockSlot {
+    uint32_t run = 0;
+    uint32_t index = 0;
+  };
+
+  // Value returned by BlockIndex() and FindEdge() when there is no such block
+  // or edge.
+  static constexpr uint32_t kNone = 0xFFFFFFFF;
+
   // Initialize processing.
   void Initialize(Function* fn);
 
@@ -229,33 +257,72 @@ class SSAPropagator {
   // the value computed by |instr|.
   Pass::Status Simulate(Instruction* instr);
 
+  // Returns the state of |inst| in the current run, or nullptr if |inst| is
+  // null or has no state.
+  const InstructionState* FindState(const Instruction* inst) const {
+    if (inst == nullptr) return nullptr;
+    const uint32_t uid = inst->unique_id();
+    if (uid >= inst_states_.size() || inst_states_[uid].run != run_) {
+      return nullptr;
+    }
+    return &inst_states_[uid];
+  }
+
+  // Returns the state of |inst| in the current run, creating it if needed.
+  InstructionState& GetState(const Instruction* inst);
+
   // Returns true if |instr| should be simulated again.
   bool ShouldSimulateAgain(Instruction* instr) const {
-    return do_not_simulate_.find(instr) == do_not_simulate_.end();
+    const InstructionState* state = FindState(instr);
+    return state == nullptr || !state->do_not_simulate;
   }
 
   // Add |instr| to the set of instructions not to simulate again.
-  void DontSimulateAgain(Instruction* instr) { do_not_simulate_.insert(instr); }
+  void DontSimulateAgain(Instruction* instr) {
+    GetState(instr).do_not_simulate = true;
+  }
+
+  // Returns the dense index of |block| in the function being propagated, or
+  // kNone if |block| is null or not in that function.
+  uint32_t BlockIndex(const BasicBlock* block) const {
+    if (block == nullptr) return kNone;
+    const uint32_t id = block->id();
+    if (id >= block_slots_.size() || block_slots_[id].run != run_) {
+      return kNone;
+    }
+    return block_slots_[id].index;
+  }
 
   // Returns true if |block| has been simulated already.
   bool BlockHasBeenSimulated(BasicBlock* block) const {
-    return simulated_blocks_.find(block) != simulated_blocks_.end();
+    const uint32_t index = BlockIndex(block);
+    return index != kNone && simulated_blocks_[index];
   }
 
   // Marks block |block| as simulated.
   void MarkBlockSimulated(BasicBlock* block) {
-    simulated_blocks_.insert(block);
+    simulated_blocks_[BlockIndex(block)] = true;
   }
 
+  // Returns the index in |successors_| of the first successor edge of
+  // |edge.source| that leads to |edge.dest|, or kNone if there is none.
+  // Parallel edges between the same blocks share the flag of the first one.
+  uint32_t FindEdge(const Edge& edge) const;
+
   // Marks |edge| as executable.  Returns false if the edge was already marked
   // as executable.
   bool MarkEdgeExecutable(const Edge& edge) {
-    return executable_edges_.insert(edge).second;
+    const uint32_t index = FindEdge(edge);
+    assert(index != kNone && "Edge is not in the CFG.");
+    if (executable_edges_[index]) return false;
+    executable_edges_[index] = true;
+    return true;
   }
 
   // Returns true if |edge| has been marked as executable.
   bool IsEdgeExecutable(const Edge& edge) const {
-    return executable_edges_.find(edge) != executable_edges_.end();
+    const uint32_t index = FindEdge(edge);
+    return index != kNone && executable_edges_[index];
   }
 
   // Returns a pointer to the def-use manager for |ctx_|.
@@ -280,35 +347,36 @@ class SSAPropagator {
   // track of interesting values by storing them in some user-provided map.
   VisitFunction visit_fn_;
 
+  // The number of the current run.  It tags the entries of |inst_states_| and
+  // |block_slots_| that belong to this run.
+  uint32_t run_;
+
   // SSA def-use edges to traverse. Each entry is a destination statement for an
-  // SSA def-use edge as returned by |def_use_manager_|.
+  // SSA def-use edge as returned by |def_use_manager_|.  The propagator drains
+  // |blocks_| before taking work from this queue.
   std::queue<Instruction*> ssa_edge_uses_;
 
   // Blocks to simulate.
   std::queue<BasicBlock*> blocks_;
 
-  // Blocks simulated during propagation.
-  std::unordered_set<BasicBlock*> simulated_blocks_;
-
-  // Set of instructions that should not be simulated again because they have
-  // been found to be in the kVarying state.
-  std::unordered_set<Instruction*> do_not_simulate_;
+  // The propagation state of every instruction, by unique id.
+  std::vector<InstructionState> inst_states_;
 
-  // Map between a basic block and its predecessor edges.
-  // TODO(dnovillo): Move this to CFG and always build them. Alternately,
-  // move it to IRContext and build CFG preds/succs on-demand.
-  std::unordered_map<BasicBlock*, std::vector<Edge>> bb_preds_;
+  // The dense index of every block of the function, by label id.
+  std::vector<BlockSlot> block_slots_;
 
-  // Map between a basic block and its successor edges.
-  // TODO(dnovillo): Move this to CFG and always build them. Alternately,
-  // move it to IRContext and build CFG preds/succs on-demand.
-  std::unordered_map<BasicBlock*, std::vector<Edge>> bb_succs_;
+  // Whether each block, by dense index, has been simulated.
+  std::vector<bool> simulated_blocks_;
 
-  // Set of executable CFG edges.
-  std::set<Edge> executable_edges_;
+  // The successor edges of the blocks, by dense index.  The successors of the
+  // block with index |b| are |successors_[successor_offsets_[b]]| up to
+  // |successors_[successor_offsets_[b + 1]]|.  Edges to the pseudo exit block
+  // are not recorded, since they are never executed.
+  std::vector<uint32_t> successor_offsets_;
+  std::vector<BasicBlock*> successors_;
 
-  // Tracks instruction propagation status.
-  std::unordered_map<Instruction*, SSAPropagator::PropStatus> statuses_;
+  // Whether each edge in |successors_| is executable.
+  std::vector<bool> executable_edges_;
 };
 
 std::ostream& operator<<(std::ostream& str,
@@ -0,0 +1,261 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/reduce_register_pressure_pass.h"
+
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace spvtools {
+namespace opt {
+
+Pass::Status ReduceRegisterPressurePass::Process() {
+  bool modified = false;
+  for (Function& func : *get_module()) {
+    if (func.IsDeclaration()) continue;
+    if (ProcessFunction(&func)) {
+      context()->MarkFunctionModified(&func);
+      modified = true;
+    }
+  }
+  return modified ? Status::SuccessWithChange : Status::SuccessWithoutChange;
+}
+
+bool ReduceRegisterPressurePass::ProcessFunction(Function* func) {
+  const RegisterLiveness* liveness =
+      context()->GetLivenessAnalysis()->Get(func);
+
+  bool modified = false;
+  size_t max_before = 0;
+  size_t max_after = 0;
+  for (BasicBlock& bb : *func) {
+    const RegisterLiveness::RegionRegisterLiveness* live_info =
+        liveness->Get(&bb);
+    if (live_info == nullptr) {
+      // Unreachable blocks have no liveness information.
+      continue;
+    }
+    size_t before = 0;
+    size_t after = 0;
+    modified |= ScheduleBlock(&bb, live_info->live_out_, &before, &after);
+    max_before = std::max(max_before, before);
+    max_after = std::max(max_after, after);
+  }
+
+  if (consumer()) {
+    std::string message = "reduce-register-pressure: function %" +
+                          std::to_string(func->result_id()) +
+                          ": maximum register pressure " +
+                          std::to_string(max_before) + " -> " +
+                          std::to_string(max_after);
+    consumer()(SPV_MSG_INFO, "", {0, 0, 0}, message.c_str());
+  }
+  return modified;
+}
+
+bool ReduceRegisterPressurePass::ScheduleBlock(BasicBlock* bb,
+                                               const LiveSet& live_out,
+                                               size_t* before, size_t* after) {
+  // The region to schedule starts after the phis and variables, and ends
+  // before the merge instruction and the terminator.
+  Instruction* region_end = bb->GetMergeInst();
+  if (region_end == nullptr) region_end = bb->terminator();
+
+  std::vector<Instruction*> region;
+  for (Instruction& inst : *bb) {
+    if (&inst == region_end) break;
+    if (region.empty() && (inst.opcode() == spv::Op::OpPhi ||
+                           inst.opcode() == spv::Op::OpVariable)) {
+      continue;
+    }
+    region.push_back(&inst);
+  }
+
+  LiveSet live_at_end = live_out;
+  for (Instruction* inst = region_end; inst != nullptr;
+       inst = inst->NextNode()) {
+    AddRegisterOperands(inst, &live_at_end);
+  }
+
+  *before = MaxPressure(region, live_at_end);
+  *after = *before;
+  if (region.size() < 2) return false;
+
+  // Build the dependence graph.  |preds[i]| holds the instructions that must
+  // stay before instruction |i|, and |num_succs[i]| counts the instructions
+  // that must stay after it.  |region_users| maps each value occupying a
+  // register to the instructions of the region that use it.
+  const size_t num_insts = region.size();
+  std::unordered_map<const Instruction*, size_t> index;
+  for (size_t i = 0; i < num_insts; ++i) index[region[i]] = i;
+
+  std::vector<std::vector<size_t>> preds(num_insts);
+  std::vector<size_t> num_succs(num_insts, 0);
+  std::unordered_map<const Instruction*, std::vector<size_t>> region_users;
+  size_t last_fixed = num_insts;
+  for (size_t i = 0; i < num_insts; ++i) {
+    Instruction* inst = region[i];
+    inst->ForEachInId([this, &index, &preds, &region_users, i](uint32_t* id) {
+      Instruction* def = get_def_use_mgr()->GetDef(*id);
+      auto it = index.find(def);
+      if (it != index.end()) preds[i].push_back(it->second);
+      if (RegisterLiveness::CreatesRegisterUsage(def)) {
+        region_users[def].push_back(i);
+      }
+    });
+    if (!IsMovable(inst)) {
+      if (last_fixed != num_insts) preds[i].push_back(last_fixed);
+      last_fixed = i;
+    }
+    std::sort(preds[i].begin(), preds[i].end());
+    preds[i].erase(std::unique(preds[i].begin(), preds[i].end()),
+                   preds[i].end());
+    for (size_t pred : preds[i]) ++num_succs[pred];
+  }
+
+  // Schedule bottom-up.  An instruction is ready once everything that must
+  // follow it has been placed.  Among the ready instructions, pick the one
+  // that increases the number of live values the least, preferring the one
+  // that comes last in the original order so that the order is kept when
+  // nothing can be gained.
+  //
+  // The cost of a ready instruction only goes down as the schedule grows,
+  // when one of its operands or its own result becomes live.  Each time that
+  // happens, the instruction is pushed again with its new cost, and the
+  // entries with an outdated cost are skipped when they reach the top.
+  LiveSet live = live_at_end;
+  auto cost_of = [this, &live, &region](size_t i) {
+    Instruction* inst = region[i];
+    LiveSet new_values;
+    inst->ForEachInId([this, &live, &new_values](uint32_t* id) {
+      Instruction* def = get_def_use_mgr()->GetDef(*id);
+      if (RegisterLiveness::CreatesRegisterUsage(def) && !live.count(def)) {
+        new_values.insert(def);
+      }
+    });
+    return static_cast<int>(new_values.size()) -
+           static_cast<int>(live.count(inst));
+  };
+
+  // The top of the queue has the lowest cost, and then the highest index.
+  using ReadyEntry = std::pair<int, size_t>;
+  std::priority_queue<ReadyEntry> ready;
+  std::vector<int> cost(num_insts, 0);
+  std::vector<bool> is_ready(num_insts, false);
+  std::vector<bool> placed(num_insts, false);
+  auto push_ready = [&ready, &cost, &cost_of](size_t i) {
+    cost[i] = cost_of(i);
+    ready.emplace(-cost[i], i);
+  };
+  for (size_t i = 0; i < num_insts; ++i) {
+    if (num_succs[i] == 0) {
+      is_ready[i] = true;
+      push_ready(i);
+    }
+  }
+
+  std::vector<Instruction*> schedule;
+  schedule.reserve(num_insts);
+  while (!ready.empty()) {
+    const size_t picked = ready.top().second;
+    const int entry_cost = -ready.top().first;
+    ready.pop();
+    if (placed[picked] || entry_cost != cost[picked]) continue;
+    placed[picked] = true;
+
+    Instruction* inst = region[picked];
+    live.erase(inst);
+    schedule.push_back(inst);
+
+    std::vector<const Instruction*> new_live;
+    inst->ForEachInId([this, &live, &new_live](uint32_t* id) {
+      Instruction* def = get_def_use_mgr()->GetDef(*id);
+      if (RegisterLiveness::CreatesRegisterUsage(def) &&
+          live.insert(def).second) {
+        new_live.push_back(def);
+      }
+    });
+    for (const Instruction* def : new_live) {
+      for (size_t user : region_users[def]) {
+        if (is_ready[user] && !placed[user]) push_ready(user);
+      }
+      auto it = index.find(def);
+      if (it != index.end() && is_ready[it->second] && !placed[it->second]) {
+        push_ready(it->second);
+      }
+    }
+
+    for (size_t pred : preds[picked]) {
+      if (--num_succs[pred] == 0) {
+        is_ready[pred] = true;
+        push_ready(pred);
+      }
+    }
+  }
+  assert(schedule.size() == num_insts && "Dependence graph has a cycle.");
+  std::reverse(schedule.begin(), schedule.end());
+
+  const size_t new_pressure = MaxPressure(schedule, live_at_end);
+  if (new_pressure >= *before) return false;
+
+  *after = new_pressure;
+  for (Instruction* inst : schedule) {
+    inst->InsertBefore(region_end);
+  }
+  return true;
+}
+
+bool ReduceRegisterPressurePass::IsMovable(Instruction* inst) {
+  if (!inst->HasResultId()) return false;
+  // Instructions that read memory, which includes every image sample, fetch,
+  // gather and read, must stay ordered with the stores and barriers around
+  // them.
+  if (inst->IsLoad() || inst->IsAtomicWithLoad()) return false;
+  switch (inst->opcode()) {
+    case spv::Op::OpPhi:
+    case spv::Op::OpVariable:
+    case spv::Op::OpUntypedVariableKHR:
+    case spv::Op::OpImageTexelPointer:
+    case spv::Op::OpArrayLength:
+      return false;
+    default:
+      break;
+  }
+  return context()->IsCombinatorInstruction(inst);
+}
+
+size_t ReduceRegisterPressurePass::MaxPressure(
+    const std::vector<Instruction*>& order, LiveSet live) const {
+  size_t max_pressure = live.size();
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    AddRegisterOperands(*it, &live);
+    max_pressure = std::max(max_pressure, live.size());
+    live.erase(*it);
+  }
+  return max_pressure;
+}
+
+void ReduceRegisterPressurePass::AddRegisterOperands(Instruction* inst,
+                                                     LiveSet* live) const {
+  inst->ForEachInId([this, live](uint32_t* id) {
+    Instruction* def = get_def_use_mgr()->GetDef(*id);
+    if (RegisterLiveness::CreatesRegisterUsage(def)) live->insert(def);
+  });
+}
+
+}  // namespace opt
+}  // namespace spvtools
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_REDUCE_REGISTER_PRESSURE_PASS_H_
+#define SOURCE_OPT_REDUCE_REGISTER_PRESSURE_PASS_H_
+
+#include <vector>
+
+#include "source/opt/ir_context.h"
+#include "source/opt/pass.h"
+#include "source/opt/register_pressure.h"
+
+namespace spvtools {
+namespace opt {
+
+// This pass reorders the instructions of every basic block to lower the
+// maximum number of SSA values that are live at the same time, as counted by
+// |RegisterLiveness|.
+//
+// Only instructions that compute a pure value from their operands, as reported
+// by |IRContext::IsCombinatorInstruction|, and that do not read memory are
+// moved.  Loads, image samples, fetches, gathers and reads, texel pointers and
+// every other instruction keep their relative order, and phis, variables, the
+// merge instruction and the terminator stay where they are.  The new order is
+// built bottom-up: starting from the values live at the end of the block, the
+// pass repeatedly places the ready instruction that adds the fewest live
+// values.  A block is rewritten only if the new order has a strictly lower
+// pressure than the original one.
+//
+// The maximum pressure of every function before and after the pass is
+// reported through the message consumer as an info message.
+class ReduceRegisterPressurePass : public Pass {
+ public:
+  const char* name() const override { return "reduce-register-pressure"; }
+  Status Process() override;
+
+  bool ReportsModifiedFunctions() const override { return true; }
+
+  IRContext::Analysis GetPreservedAnalyses() override {
+    return IRContext::kAnalysisDefUse |
+           IRContext::kAnalysisInstrToBlockMapping |
+           IRContext::kAnalysisDecorations | IRContext::kAnalysisCombinators |
+           IRContext::kAnalysisCFG | IRContext::kAnalysisDominatorAnalysis |
+           IRContext::kAnalysisLoopAnalysis | IRContext::kAnalysisNameMap |
+           IRContext::kAnalysisConstants | IRContext::kAnalysisTypes;
+  }
+
+ private:
+  using LiveSet = RegisterLiveness::RegionRegisterLiveness::LiveSet;
+
+  // Schedules the blocks of |func|.  Returns true if |func| was changed.
+  bool ProcessFunction(Function* func);
+
+  // Reorders the movable instructions of |bb|, whose live-out values are
+  // |live_out|.  The maximum pressure of the block before and after the
+  // reordering is returned in |before| and |after|.  Returns true if |bb| was
+  // changed.
+  bool ScheduleBlock(BasicBlock* bb, const LiveSet& live_out, size_t* before,
+                     size_t* after);
+
+  // Returns true if |inst| may be placed anywhere in its block between the
+  // definitions of its operands and its first user.
+  bool IsMovable(Instruction* inst);
+
+  // Returns the maximum number of values live at once while |order| executes,
+  // given that |live| holds the values live after its last instruction.
+  size_t MaxPressure(const std::vector<Instruction*>& order,
+                     LiveSet live) const;
+
+  // Adds to |live| the operands of |inst| that occupy a register.
+  void AddRegisterOperands(Instruction* inst, LiveSet* live) const;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_REDUCE_REGISTER_PRESSURE_PASS_H_
@@ -24,7 +24,7 @@ Pass::Status RedundancyEliminationPass::Process() {
   ValueNumberTable vnTable(context());
 
   for (auto& func : *get_module()) {
-    if (func.IsDeclaration()) {
+    if (func.IsDeclaration() || IsFunctionUnchanged(&func)) {
       continue;
     }
 
@@ -34,6 +34,7 @@ Pass::Status RedundancyEliminationPass::Process() {
         context()->GetDominatorAnalysis(&func)->GetDomTree();
 
     if (EliminateRedundanciesFrom(dom_tree.GetRoot(), vnTable)) {
+      context()->MarkFunctionModified(&func);
       modified = true;
     }
   }
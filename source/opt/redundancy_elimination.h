@@ -34,6 +34,9 @@ class RedundancyEliminationPass : public LocalRedundancyEliminationPass {
   const char* name() const override { return "redundancy-elimination"; }
   Status Process() override;
 
+  bool ReportsModifiedFunctions() const override { return true; }
+  bool SupportsIncrementalProcessing() const override { return true; }
+
  protected:
   // Removes for all total redundancies in the function starting at |bb|.
   //
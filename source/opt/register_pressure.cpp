@@ -44,16 +44,6 @@ class ExcludePhiDefinedInBlock {
   const BasicBlock* bb_;
 };
 
-// Returns true if |insn| generates a SSA register that is likely to require a
-// physical register.
-bool CreatesRegisterUsage(Instruction* insn) {
-  if (!insn->HasResultId()) return false;
-  if (insn->opcode() == spv::Op::OpUndef) return false;
-  if (IsConstantInst(insn->opcode())) return false;
-  if (insn->opcode() == spv::Op::OpLabel) return false;
-  return true;
-}
-
 // Compute the register liveness for each basic block of a function. This also
 // fill-up some information about the pick register usage and a break down of
 // register usage. This implements: "A non-iterative data-flow algorithm for
@@ -104,7 +94,7 @@ class ComputeRegisterLiveness {
           if (phi->GetSingleWordInOperand(i + 1) == bb_id) {
             Instruction* insn_op =
                 def_use_manager_.GetDef(phi->GetSingleWordInOperand(i));
-            if (CreatesRegisterUsage(insn_op)) {
+            if (RegisterLiveness::CreatesRegisterUsage(insn_op)) {
               live->insert(insn_op);
               break;
             }
@@ -153,7 +143,7 @@ class ComputeRegisterLiveness {
       live_inout->live_in_.erase(&insn);
       insn.ForEachInId([live_inout, this](uint32_t* id) {
         Instruction* insn_op = def_use_manager_.GetDef(*id);
-        if (CreatesRegisterUsage(insn_op)) {
+        if (RegisterLiveness::CreatesRegisterUsage(insn_op)) {
           live_inout->live_in_.insert(insn_op);
         }
       });
@@ -230,7 +220,7 @@ class ComputeRegisterLiveness {
         insn.ForEachInId(
             [live_inout, &die_in_block, &reg_count, this](uint32_t* id) {
               Instruction* op_insn = def_use_manager_.GetDef(*id);
-              if (!CreatesRegisterUsage(op_insn) ||
+              if (!RegisterLiveness::CreatesRegisterUsage(op_insn) ||
                   live_inout->live_out_.count(op_insn)) {
                 // already taken into account.
                 return;
@@ -243,7 +233,7 @@ class ComputeRegisterLiveness {
             });
         live_inout->used_registers_ =
             std::max(live_inout->used_registers_, reg_count);
-        if (CreatesRegisterUsage(&insn)) {
+        if (RegisterLiveness::CreatesRegisterUsage(&insn)) {
           reg_count--;
         }
       }
@@ -260,6 +250,14 @@ class ComputeRegisterLiveness {
 };
 }  // namespace
 
+bool RegisterLiveness::CreatesRegisterUsage(Instruction* insn) {
+  if (!insn->HasResultId()) return false;
+  if (insn->opcode() == spv::Op::OpUndef) return false;
+  if (IsConstantInst(insn->opcode())) return false;
+  if (insn->opcode() == spv::Op::OpLabel) return false;
+  return true;
+}
+
 // Get the number of required registers for each basic block.
 void RegisterLiveness::RegionRegisterLiveness::AddRegisterClass(
     Instruction* insn) {
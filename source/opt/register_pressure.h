@@ -106,6 +106,10 @@ class RegisterLiveness {
 
   IRContext* GetContext() const { return context_; }
 
+  // Returns true if |insn| generates a SSA register that is likely to require a
+  // physical register.
+  static bool CreatesRegisterUsage(Instruction* insn);
+
   // Returns liveness and register information for the basic block |bb|. If no
   // entry exist for the basic block, the function returns null.
   RegionRegisterLiveness* Get(const BasicBlock* bb) { return Get(bb->id()); }
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "source/opt/ir_context.h"
+#include "source/util/hash_combine.h"
 
 // Transforms a given scalar operation instruction into a DAG representation.
 //
@@ -372,6 +373,15 @@ SENode* ScalarEvolutionAnalysis::GetCachedOrAdd(
   return raw_ptr_to_node;
 }
 
+bool ScalarEvolutionAnalysis::IsCached(SENode* node) const {
+  // The cache is keyed by owning pointers, so look |node| up through one that
+  // is released before it goes out of scope.
+  std::unique_ptr<SENode> key(node);
+  auto itr = node_cache_.find(key);
+  key.release();
+  return itr != node_cache_.end() && itr->get() == node;
+}
+
 bool ScalarEvolutionAnalysis::IsLoopInvariant(const Loop* loop,
                                               const SENode* node) const {
   for (auto itr = node->graph_cbegin(); itr != node->graph_cend(); ++itr) {
@@ -546,85 +556,35 @@ bool SENode::operator==(const SENode& other) const {
 
 bool SENode::operator!=(const SENode& other) const { return !(*this == other); }
 
-namespace {
-// Helper functions to insert 32/64 bit values into the 32 bit hash string. This
-// allows us to add pointers to the string by reinterpreting the pointers as
-// uintptr_t. PushToString will deduce the type, call sizeof on it and use
-// that size to call into the correct PushToStringImpl functor depending on
-// whether it is 32 or 64 bit.
-
-template <typename T, size_t size_of_t>
-struct PushToStringImpl;
-
-template <typename T>
-struct PushToStringImpl<T, 8> {
-  void operator()(T id, std::u32string* str) {
-    str->push_back(static_cast<uint32_t>(id >> 32));
-    str->push_back(static_cast<uint32_t>(id));
-  }
-};
-
-template <typename T>
-struct PushToStringImpl<T, 4> {
-  void operator()(T id, std::u32string* str) {
-    str->push_back(static_cast<uint32_t>(id));
-  }
-};
-
-template <typename T>
-void PushToString(T id, std::u32string* str) {
-  PushToStringImpl<T, sizeof(T)>{}(id, str);
-}
-
-}  // namespace
-
 // Implements the hashing of SENodes.
 size_t SENodeHash::operator()(const SENode* node) const {
-  // Concatenate the terms into a string which we can hash.
-  std::u32string hash_string{};
-
-  // Hashing the type as a string is safer than hashing the enum as the enum is
-  // very likely to collide with constants.
-  for (char ch : node->AsString()) {
-    hash_string.push_back(static_cast<char32_t>(ch));
-  }
+  size_t hash = std::hash<uint32_t>{}(static_cast<uint32_t>(node->GetType()));
 
   // We just ignore the literal value unless it is a constant.
-  if (node->GetType() == SENode::Constant)
-    PushToString(node->AsSEConstantNode()->FoldToSingleValue(), &hash_string);
-
-  const SERecurrentNode* recurrent = node->AsSERecurrentNode();
+  if (node->GetType() == SENode::Constant) {
+    hash = utils::hash_combine(hash,
+                               node->AsSEConstantNode()->FoldToSingleValue());
+  }
 
   // If we're dealing with a recurrent expression hash the loop as well so that
   // nested inductions like i=0,i++ and j=0,j++ correspond to different nodes.
-  if (recurrent) {
-    PushToString(reinterpret_cast<uintptr_t>(recurrent->GetLoop()),
-                 &hash_string);
-
-    // Recurrent expressions can't be hashed using the normal method as the
-    // order of coefficient and offset matters to the hash.
-    PushToString(reinterpret_cast<uintptr_t>(recurrent->GetCoefficient()),
-                 &hash_string);
-    PushToString(reinterpret_cast<uintptr_t>(recurrent->GetOffset()),
-                 &hash_string);
-
-    return std::hash<std::u32string>{}(hash_string);
+  // Recurrent expressions can't be hashed using the normal method as the order
+  // of coefficient and offset matters to the hash.
+  if (const SERecurrentNode* recurrent = node->AsSERecurrentNode()) {
+    return utils::hash_combine(hash, recurrent->GetLoop(),
+                               recurrent->GetCoefficient(),
+                               recurrent->GetOffset());
   }
 
   // Hash the result id of the original instruction which created this node if
   // it is a value unknown node.
   if (node->GetType() == SENode::ValueUnknown) {
-    PushToString(node->AsSEValueUnknown()->ResultId(), &hash_string);
+    hash = utils::hash_combine(hash, node->AsSEValueUnknown()->ResultId());
   }
 
   // Hash the pointers of the child nodes, each SENode has a unique pointer
   // associated with it.
-  const std::vector<SENode*>& children = node->GetChildren();
-  for (const SENode* child : children) {
-    PushToString(reinterpret_cast<uintptr_t>(child), &hash_string);
-  }
-
-  return std::hash<std::u32string>{}(hash_string);
+  return utils::hash_combine(hash, node->GetChildren());
 }
 
 // This overload is the actual overload used by the node_cache_ set.
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -91,6 +92,10 @@ class ScalarEvolutionAnalysis {
   // |prospective_node| is already in the cache just return the raw pointer.
   SENode* GetCachedOrAdd(std::unique_ptr<SENode> prospective_node);
 
+  // Returns true if |node| is owned by the cache, rather than being a
+  // temporary node built by a caller.
+  bool IsCached(SENode* node) const;
+
   // Checks that the graph starting from |node| is invariant to the |loop|.
   bool IsLoopInvariant(const Loop* loop, const SENode* node) const;
 
@@ -166,6 +171,13 @@ class ScalarEvolutionAnalysis {
   std::unordered_set<std::unique_ptr<SENode>, SENodeHash, NodePointersEquality>
       node_cache_;
 
+  // The simplified form of each node of |node_cache_| given to
+  // SimplifyExpression. Cached nodes are not modified and live as long as the
+  // analysis, so a node always simplifies to the same node. The same
+  // subexpressions are simplified over and over by the loop dependence
+  // analysis.
+  std::unordered_map<const SENode*, SENode*> simplified_nodes_;
+
   // Loops that should be considered the same for performing analysis for loop
   // fusion.
   std::map<const Loop*, const Loop*> pretend_equal_;
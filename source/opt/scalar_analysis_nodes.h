@@ -189,6 +189,9 @@ class SENode {
     return parent_analysis_;
   }
 
+  // Returns the id assigned to this node on creation. Ids are never reused.
+  inline uint32_t UniqueId() const { return unique_id_; }
+
  protected:
   ChildContainerType children_;
 
@@ -204,8 +207,8 @@ class SENode {
 // clang-format on
 
 // Function object to handle the hashing of SENodes. Hashing algorithm hashes
-// the type (as a string), the literal value of any constants, and the child
-// pointers which are assumed to be unique.
+// the type, the literal value of any constants, and the child pointers which
+// are assumed to be unique.
 struct SENodeHash {
   size_t operator()(const std::unique_ptr<SENode>& node) const;
   size_t operator()(const SENode* node) const;
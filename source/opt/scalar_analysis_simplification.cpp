@@ -516,7 +516,7 @@ SENode* SENodeSimplifyImpl::SimplifyRecurrentAddExpression(
   if (simplified_child->GetType() != SENode::CanNotCompute) {
     recurrent_node->AddOffset(simplified_child);
   } else {
-    recurrent_expr->AddOffset(analysis_.GetCachedOrAdd(std::move(new_offset)));
+    recurrent_node->AddOffset(analysis_.GetCachedOrAdd(std::move(new_offset)));
   }
 
   recurrent_node->AddCoefficient(recurrent_expr->GetCoefficient());
@@ -529,9 +529,20 @@ SENode* SENodeSimplifyImpl::SimplifyRecurrentAddExpression(
  */
 
 SENode* ScalarEvolutionAnalysis::SimplifyExpression(SENode* node) {
-  SENodeSimplifyImpl impl{this, node};
+  // Temporary nodes are not memoized: they may be modified or freed after
+  // this call, and their address reused by another node.
+  const bool memoize = IsCached(node);
+  if (memoize) {
+    auto itr = simplified_nodes_.find(node);
+    if (itr != simplified_nodes_.end()) {
+      return itr->second;
+    }
+  }
 
-  return impl.Simplify();
+  SENodeSimplifyImpl impl{this, node};
+  SENode* simplified = impl.Simplify();
+  if (memoize) simplified_nodes_[node] = simplified;
+  return simplified;
 }
 
 }  // namespace opt
@@ -26,7 +26,11 @@ Pass::Status SimplificationPass::Process() {
   bool modified = false;
 
   for (Function& function : *get_module()) {
-    modified |= SimplifyFunction(&function);
+    if (IsFunctionUnchanged(&function)) continue;
+    if (SimplifyFunction(&function)) {
+      context()->MarkFunctionModified(&function);
+      modified = true;
+    }
   }
   return (modified ? Status::SuccessWithChange : Status::SuccessWithoutChange);
 }
@@ -15,6 +15,7 @@
 #ifndef SOURCE_VAL_DECORATION_H_
 #define SOURCE_VAL_DECORATION_H_
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <unordered_map>
@@ -103,6 +104,73 @@ class Decoration {
   int struct_member_index_;
 };
 
+// The set of decorations applied to a single <id>.
+//
+// The decorations are stored in a sorted array, so that the decorations of an
+// <id> are contiguous in memory.  They are ordered by Decoration::operator<, so
+// the decorations of each struct member form a contiguous range that can be
+// found with lower_bound() and upper_bound().
+//
+// In addition, the set keeps one presence bit per decoration kind for the
+// kinds whose value is less than 63, which covers the core decorations, and a
+// shared bit for all other kinds.  This makes HasType() constant time for the
+// core decorations.
+class DecorationSet {
+ public:
+  using const_iterator = std::vector<Decoration>::const_iterator;
+
+  const_iterator begin() const { return decorations_.begin(); }
+  const_iterator end() const { return decorations_.end(); }
+  size_t size() const { return decorations_.size(); }
+  bool empty() const { return decorations_.empty(); }
+
+  // Adds |dec| to the set, unless an equal decoration is already in it.
+  void insert(const Decoration& dec) {
+    auto iter = std::lower_bound(decorations_.begin(), decorations_.end(), dec);
+    if (iter != decorations_.end() && *iter == dec) return;
+    decorations_.insert(iter, dec);
+    kind_mask_ |= KindBit(dec.dec_type());
+  }
+
+  // Adds the decorations in [|first|, |last|) to the set.
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  const_iterator lower_bound(const Decoration& dec) const {
+    return std::lower_bound(decorations_.begin(), decorations_.end(), dec);
+  }
+  const_iterator upper_bound(const Decoration& dec) const {
+    return std::upper_bound(decorations_.begin(), decorations_.end(), dec);
+  }
+
+  // Returns true if the set contains a decoration of kind |type|, applied to
+  // the <id> itself or to one of its members.
+  bool HasType(spv::Decoration type) const {
+    const uint64_t bit = KindBit(type);
+    if ((kind_mask_ & bit) == 0) return false;
+    if (bit != kOtherKindsBit) return true;
+    return std::any_of(
+        decorations_.begin(), decorations_.end(),
+        [type](const Decoration& d) { return d.dec_type() == type; });
+  }
+
+ private:
+  // The presence bit shared by all decoration kinds whose value is at least
+  // 63.
+  static constexpr uint64_t kOtherKindsBit = uint64_t(1) << 63;
+
+  // Returns the presence bit of decoration kind |type|.
+  static uint64_t KindBit(spv::Decoration type) {
+    const auto kind = static_cast<uint32_t>(type);
+    return kind < 63 ? uint64_t(1) << kind : kOtherKindsBit;
+  }
+
+  std::vector<Decoration> decorations_;
+  uint64_t kind_mask_ = 0;
+};
+
 }  // namespace val
 }  // namespace spvtools
 
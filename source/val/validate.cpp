@@ -14,6 +14,7 @@
 
 #include "source/val/validate.h"
 
+#include <cassert>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -118,6 +119,7 @@ spv_result_t ValidateForwardDecls(ValidationState_t& _) {
 spv_result_t ValidateEntryPoints(ValidationState_t& _) {
   _.ComputeFunctionToEntryPointMapping();
   _.ComputeRecursiveEntryPoints();
+  _.ComputeEntryPointReferences();
 
   if (_.entry_points().empty() && !_.HasCapability(spv::Capability::Linkage) &&
       !_.HasCapability(spv::Capability::GraphARM)) {
@@ -166,6 +168,107 @@ spv_result_t ValidateGraphEntryPoints(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
+// The per-instruction validation passes, each paired with a predicate telling
+// which opcodes it can act on.  A pass with a null predicate runs on every
+// instruction.  The predicates are defined next to their passes, see
+// validate.h.
+//
+// Keep these passes in the order they appear in the SPIR-V specification
+// sections to maintain test consistency.
+using InstructionPassFn = spv_result_t (*)(ValidationState_t&,
+                                           const Instruction*);
+
+struct InstructionPassEntry {
+  InstructionPassFn pass;
+  bool (*applies)(spv::Op);
+};
+
+const InstructionPassEntry kInstructionPasses[] = {
+    {MiscPass, MiscPassApplies},
+    {DebugPass, DebugPassApplies},
+    {AnnotationPass, nullptr},
+    {ExtensionPass, ExtensionPassApplies},
+    {ModeSettingPass, ModeSettingPassApplies},
+    {TypePass, TypePassApplies},
+    {ConstantPass, ConstantPassApplies},
+    {MemoryPass, MemoryPassApplies},
+    {FunctionPass, FunctionPassApplies},
+    {ImagePass, ImagePassApplies},
+    {ConversionPass, ConversionPassApplies},
+    {CompositesPass, CompositesPassApplies},
+    {ArithmeticsPass, ArithmeticsPassApplies},
+    {BitwisePass, BitwisePassApplies},
+    {LogicalsPass, LogicalsPassApplies},
+    {ControlFlowPass, ControlFlowPassApplies},
+    {DerivativesPass, DerivativesPassApplies},
+    {AtomicsPass, AtomicsPassApplies},
+    {PrimitivesPass, PrimitivesPassApplies},
+    {BarriersPass, BarriersPassApplies},
+    {DotProductPass, DotProductPassApplies},
+    {GroupPass, GroupPassApplies},
+    {PipePass, PipePassApplies},
+    {NonUniformPass, NonUniformPassApplies},
+    {LiteralsPass, nullptr},
+    {RayQueryPass, RayQueryPassApplies},
+    {RayTracingPass, RayTracingPassApplies},
+    {RayReorderNVPass, RayReorderNVPassApplies},
+    {RayReorderEXTPass, RayReorderEXTPassApplies},
+    {MeshShadingPass, MeshShadingPassApplies},
+    {TensorLayoutPass, TensorLayoutPassApplies},
+    {TensorPass, TensorPassApplies},
+    {GraphPass, GraphPassApplies},
+    {InvalidTypePass, InvalidTypePassApplies},
+};
+
+// Maps opcodes to the instruction passes that apply to them.  The list for an
+// opcode is computed the first time that opcode is seen, so validating an
+// instruction only calls the passes that can act on it.
+class InstructionPassDispatcher {
+ public:
+  const std::vector<InstructionPassFn>& PassesFor(spv::Op opcode) {
+    const size_t index = static_cast<size_t>(opcode);
+    if (index >= list_for_opcode_.size()) {
+      list_for_opcode_.resize(index + 1, kNoList);
+    }
+    uint32_t& list = list_for_opcode_[index];
+    if (list == kNoList) {
+      list = static_cast<uint32_t>(lists_.size());
+      lists_.emplace_back();
+      for (const auto& entry : kInstructionPasses) {
+        if (!entry.applies || entry.applies(opcode)) {
+          lists_.back().push_back(entry.pass);
+        }
+      }
+    }
+    return lists_[list];
+  }
+
+ private:
+  static constexpr uint32_t kNoList = ~0u;
+
+  // Index into |lists_| for each opcode, or kNoList if not yet computed.
+  std::vector<uint32_t> list_for_opcode_;
+  std::vector<std::vector<InstructionPassFn>> lists_;
+};
+
+#ifndef NDEBUG
+// Checks that the passes whose predicate rejects the opcode of |inst| have
+// nothing to report on it.  A failure means that a pass handles an opcode
+// that is missing from its predicate, so release builds would silently skip
+// that check.
+void CheckSkippedInstructionPasses(ValidationState_t& _,
+                                   const Instruction* inst) {
+  for (const auto& entry : kInstructionPasses) {
+    if (!entry.applies || entry.applies(inst->opcode())) continue;
+    const spv_result_t result = entry.pass(_, inst);
+    assert(result == SPV_SUCCESS &&
+           "An instruction pass found an error in an instruction rejected by "
+           "its predicate.");
+    (void)result;
+  }
+}
+#endif
+
 spv_result_t ValidateBinaryUsingContextAndValidationState(
     const spv_context_t& context, const uint32_t* words, const size_t num_words,
     spv_diagnostic* pDiagnostic, ValidationState_t* vstate) {
@@ -372,47 +475,16 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   }
 
   // Validate individual opcodes.
+  InstructionPassDispatcher dispatcher;
   for (size_t i = 0; i < vstate->ordered_instructions().size(); ++i) {
     auto& instruction = vstate->ordered_instructions()[i];
 
-    // Keep these passes in the order they appear in the SPIR-V specification
-    // sections to maintain test consistency.
-    if (auto error = MiscPass(*vstate, &instruction)) return error;
-    if (auto error = DebugPass(*vstate, &instruction)) return error;
-    if (auto error = AnnotationPass(*vstate, &instruction)) return error;
-    if (auto error = ExtensionPass(*vstate, &instruction)) return error;
-    if (auto error = ModeSettingPass(*vstate, &instruction)) return error;
-    if (auto error = TypePass(*vstate, &instruction)) return error;
-    if (auto error = ConstantPass(*vstate, &instruction)) return error;
-    if (auto error = MemoryPass(*vstate, &instruction)) return error;
-    if (auto error = FunctionPass(*vstate, &instruction)) return error;
-    if (auto error = ImagePass(*vstate, &instruction)) return error;
-    if (auto error = ConversionPass(*vstate, &instruction)) return error;
-    if (auto error = CompositesPass(*vstate, &instruction)) return error;
-    if (auto error = ArithmeticsPass(*vstate, &instruction)) return error;
-    if (auto error = BitwisePass(*vstate, &instruction)) return error;
-    if (auto error = LogicalsPass(*vstate, &instruction)) return error;
-    if (auto error = ControlFlowPass(*vstate, &instruction)) return error;
-    if (auto error = DerivativesPass(*vstate, &instruction)) return error;
-    if (auto error = AtomicsPass(*vstate, &instruction)) return error;
-    if (auto error = PrimitivesPass(*vstate, &instruction)) return error;
-    if (auto error = BarriersPass(*vstate, &instruction)) return error;
-    if (auto error = DotProductPass(*vstate, &instruction)) return error;
-    if (auto error = GroupPass(*vstate, &instruction)) return error;
-    // Device-Side Enqueue
-    if (auto error = PipePass(*vstate, &instruction)) return error;
-    if (auto error = NonUniformPass(*vstate, &instruction)) return error;
-
-    if (auto error = LiteralsPass(*vstate, &instruction)) return error;
-    if (auto error = RayQueryPass(*vstate, &instruction)) return error;
-    if (auto error = RayTracingPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderNVPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderEXTPass(*vstate, &instruction)) return error;
-    if (auto error = MeshShadingPass(*vstate, &instruction)) return error;
-    if (auto error = TensorLayoutPass(*vstate, &instruction)) return error;
-    if (auto error = TensorPass(*vstate, &instruction)) return error;
-    if (auto error = GraphPass(*vstate, &instruction)) return error;
-    if (auto error = InvalidTypePass(*vstate, &instruction)) return error;
+    for (const auto pass : dispatcher.PassesFor(instruction.opcode())) {
+      if (auto error = pass(*vstate, &instruction)) return error;
+    }
+#ifndef NDEBUG
+    CheckSkippedInstructionPasses(*vstate, &instruction);
+#endif
   }
 
   // Validate the preconditions involving adjacent instructions. e.g.
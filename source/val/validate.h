@@ -252,6 +252,44 @@ void ReachabilityPass(ValidationState_t& _);
 /// Validates tensor layout and view instructions.
 spv_result_t TensorLayoutPass(ValidationState_t& _, const Instruction* inst);
 
+/// Opcode predicates of the instruction passes.  Each returns true if its pass
+/// can act on instructions with |opcode|; the passes are only called on those
+/// instructions.  Each predicate is defined next to its pass, and must accept
+/// every opcode that the pass handles.  Debug builds also run each pass on
+/// the instructions its predicate rejects, and assert that it finds no error.
+bool MiscPassApplies(spv::Op opcode);
+bool DebugPassApplies(spv::Op opcode);
+bool ExtensionPassApplies(spv::Op opcode);
+bool ModeSettingPassApplies(spv::Op opcode);
+bool TypePassApplies(spv::Op opcode);
+bool ConstantPassApplies(spv::Op opcode);
+bool MemoryPassApplies(spv::Op opcode);
+bool FunctionPassApplies(spv::Op opcode);
+bool ImagePassApplies(spv::Op opcode);
+bool ConversionPassApplies(spv::Op opcode);
+bool CompositesPassApplies(spv::Op opcode);
+bool ArithmeticsPassApplies(spv::Op opcode);
+bool BitwisePassApplies(spv::Op opcode);
+bool LogicalsPassApplies(spv::Op opcode);
+bool ControlFlowPassApplies(spv::Op opcode);
+bool DerivativesPassApplies(spv::Op opcode);
+bool AtomicsPassApplies(spv::Op opcode);
+bool PrimitivesPassApplies(spv::Op opcode);
+bool BarriersPassApplies(spv::Op opcode);
+bool DotProductPassApplies(spv::Op opcode);
+bool GroupPassApplies(spv::Op opcode);
+bool PipePassApplies(spv::Op opcode);
+bool NonUniformPassApplies(spv::Op opcode);
+bool RayQueryPassApplies(spv::Op opcode);
+bool RayTracingPassApplies(spv::Op opcode);
+bool RayReorderNVPassApplies(spv::Op opcode);
+bool RayReorderEXTPassApplies(spv::Op opcode);
+bool MeshShadingPassApplies(spv::Op opcode);
+bool TensorLayoutPassApplies(spv::Op opcode);
+bool TensorPassApplies(spv::Op opcode);
+bool GraphPassApplies(spv::Op opcode);
+bool InvalidTypePassApplies(spv::Op opcode);
+
 /// Validates execution limitations.
 ///
 /// Verifies execution models are allowed for all functionality they contain.
@@ -838,6 +838,47 @@ spv_result_t ValidateCooperativeMatrixReduceNV(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
+bool ArithmeticsPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpFAdd:
+    case spv::Op::OpFSub:
+    case spv::Op::OpFMul:
+    case spv::Op::OpFDiv:
+    case spv::Op::OpFRem:
+    case spv::Op::OpFMod:
+    case spv::Op::OpFNegate:
+    case spv::Op::OpFmaKHR:
+    case spv::Op::OpUDiv:
+    case spv::Op::OpUMod:
+    case spv::Op::OpISub:
+    case spv::Op::OpIAdd:
+    case spv::Op::OpIMul:
+    case spv::Op::OpSDiv:
+    case spv::Op::OpSMod:
+    case spv::Op::OpSRem:
+    case spv::Op::OpSNegate:
+    case spv::Op::OpDot:
+    case spv::Op::OpVectorTimesScalar:
+    case spv::Op::OpMatrixTimesScalar:
+    case spv::Op::OpVectorTimesMatrix:
+    case spv::Op::OpMatrixTimesVector:
+    case spv::Op::OpMatrixTimesMatrix:
+    case spv::Op::OpOuterProduct:
+    case spv::Op::OpIAddCarry:
+    case spv::Op::OpISubBorrow:
+    case spv::Op::OpUMulExtended:
+    case spv::Op::OpSMulExtended:
+    case spv::Op::OpCooperativeMatrixMulAddNV:
+    case spv::Op::OpCooperativeMatrixMulAddKHR:
+    case spv::Op::OpCooperativeMatrixReduceNV:
+    case spv::Op::OpSpecConstantOp:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of arithmetic instructions.
 spv_result_t ArithmeticsPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
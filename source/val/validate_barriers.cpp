@@ -27,6 +27,21 @@
 namespace spvtools {
 namespace val {
 
+bool BarriersPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpControlBarrier:
+    case spv::Op::OpControlBarrierArriveEXT:
+    case spv::Op::OpControlBarrierWaitEXT:
+    case spv::Op::OpMemoryBarrier:
+    case spv::Op::OpNamedBarrierInitialize:
+    case spv::Op::OpMemoryNamedBarrier:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of barrier instructions.
 spv_result_t BarriersPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
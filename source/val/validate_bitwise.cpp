@@ -226,6 +226,28 @@ spv_result_t ValidateBitCount(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool BitwisePassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpShiftRightLogical:
+    case spv::Op::OpShiftRightArithmetic:
+    case spv::Op::OpShiftLeftLogical:
+    case spv::Op::OpBitwiseOr:
+    case spv::Op::OpBitwiseXor:
+    case spv::Op::OpBitwiseAnd:
+    case spv::Op::OpNot:
+    case spv::Op::OpBitFieldInsert:
+    case spv::Op::OpBitFieldSExtract:
+    case spv::Op::OpBitFieldUExtract:
+    case spv::Op::OpBitReverse:
+    case spv::Op::OpBitCount:
+    case spv::Op::OpSpecConstantOp:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of bitwise instructions.
 spv_result_t BitwisePass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
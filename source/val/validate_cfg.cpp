@@ -1281,6 +1281,23 @@ void ReachabilityPass(ValidationState_t& _) {
   }
 }
 
+bool ControlFlowPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpPhi:
+    case spv::Op::OpBranch:
+    case spv::Op::OpBranchConditional:
+    case spv::Op::OpReturnValue:
+    case spv::Op::OpSwitch:
+    case spv::Op::OpLoopMerge:
+    case spv::Op::OpLifetimeStart:
+    case spv::Op::OpLifetimeStop:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t ControlFlowPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpPhi:
@@ -1144,6 +1144,29 @@ spv_result_t ValidateExtractSubArrayQCOM(ValidationState_t& _,
 }
 
 }  // anonymous namespace
+bool CompositesPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpVectorExtractDynamic:
+    case spv::Op::OpVectorInsertDynamic:
+    case spv::Op::OpVectorShuffle:
+    case spv::Op::OpCompositeConstruct:
+    case spv::Op::OpCompositeConstructReplicateEXT:
+    case spv::Op::OpCompositeExtract:
+    case spv::Op::OpCompositeInsert:
+    case spv::Op::OpCopyObject:
+    case spv::Op::OpTranspose:
+    case spv::Op::OpCopyLogical:
+    case spv::Op::OpCompositeConstructCoopMatQCOM:
+    case spv::Op::OpCompositeExtractCoopMatQCOM:
+    case spv::Op::OpExtractSubArrayQCOM:
+    case spv::Op::OpSpecConstantOp:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of composite instructions.
 spv_result_t CompositesPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
@@ -743,6 +743,30 @@ spv_result_t ValidateConstantData(ValidationState_t& _,
 
 }  // namespace
 
+bool ConstantPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpConstantTrue:
+    case spv::Op::OpConstantFalse:
+    case spv::Op::OpSpecConstantTrue:
+    case spv::Op::OpSpecConstantFalse:
+    case spv::Op::OpConstantComposite:
+    case spv::Op::OpSpecConstantComposite:
+    case spv::Op::OpConstantCompositeReplicateEXT:
+    case spv::Op::OpSpecConstantCompositeReplicateEXT:
+    case spv::Op::OpConstantSampler:
+    case spv::Op::OpConstantNull:
+    case spv::Op::OpSpecConstant:
+    case spv::Op::OpSpecConstantOp:
+    case spv::Op::OpConstantSizeOfEXT:
+    case spv::Op::OpConstantFunctionPointerINTEL:
+    case spv::Op::OpConstantDataKHR:
+      return true;
+    default:
+      break;
+  }
+  return spvOpcodeIsConstant(opcode);
+}
+
 spv_result_t ConstantPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpConstantTrue:
@@ -1020,6 +1020,37 @@ spv_result_t ValidateBitCastArray(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
+bool ConversionPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpConvertFToU:
+    case spv::Op::OpConvertFToS:
+    case spv::Op::OpConvertSToF:
+    case spv::Op::OpConvertUToF:
+    case spv::Op::OpUConvert:
+    case spv::Op::OpSConvert:
+    case spv::Op::OpFConvert:
+    case spv::Op::OpQuantizeToF16:
+    case spv::Op::OpConvertPtrToU:
+    case spv::Op::OpSatConvertSToU:
+    case spv::Op::OpSatConvertUToS:
+    case spv::Op::OpConvertUToPtr:
+    case spv::Op::OpPtrCastToGeneric:
+    case spv::Op::OpGenericCastToPtr:
+    case spv::Op::OpGenericCastToPtrExplicit:
+    case spv::Op::OpBitcast:
+    case spv::Op::OpBitcastExtractEXT:
+    case spv::Op::OpConvertUToAccelerationStructureKHR:
+    case spv::Op::OpCooperativeMatrixConvertNV:
+    case spv::Op::OpCooperativeMatrixTransposeNV:
+    case spv::Op::OpBitCastArrayQCOM:
+    case spv::Op::OpSpecConstantOp:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of conversion instructions.
 spv_result_t ConversionPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
@@ -53,6 +53,17 @@ spv_result_t ValidateLine(ValidationState_t& _, const Instruction* inst) {
 
 }  // namespace
 
+bool DebugPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpMemberName:
+    case spv::Op::OpLine:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t DebugPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpMemberName:
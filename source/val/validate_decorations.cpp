@@ -1237,9 +1237,9 @@ spv_result_t CheckDecorationsFromDecoration(ValidationState_t& vstate) {
   const bool is_shader = vstate.HasCapability(spv::Capability::Shader);
   const bool is_kernel = vstate.HasCapability(spv::Capability::Kernel);
 
-  for (const auto& kv : vstate.id_decorations()) {
-    const uint32_t id = kv.first;
-    const auto& decorations = kv.second;
+  const auto& id_decorations = vstate.id_decorations();
+  for (uint32_t id = 0; id < id_decorations.size(); ++id) {
+    const auto& decorations = id_decorations[id];
     if (decorations.empty()) continue;
 
     const Instruction* inst = vstate.FindDef(id);
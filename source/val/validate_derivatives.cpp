@@ -24,6 +24,24 @@
 namespace spvtools {
 namespace val {
 
+bool DerivativesPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpDPdx:
+    case spv::Op::OpDPdy:
+    case spv::Op::OpFwidth:
+    case spv::Op::OpDPdxFine:
+    case spv::Op::OpDPdyFine:
+    case spv::Op::OpFwidthFine:
+    case spv::Op::OpDPdxCoarse:
+    case spv::Op::OpDPdyCoarse:
+    case spv::Op::OpFwidthCoarse:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of derivative instructions.
 spv_result_t DerivativesPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
@@ -377,6 +377,24 @@ spv_result_t ValidateFDot4MixAcc32(ValidationState_t& _,
 
 }  // namespace
 
+bool DotProductPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpSDot:
+    case spv::Op::OpUDot:
+    case spv::Op::OpSUDot:
+    case spv::Op::OpSDotAccSat:
+    case spv::Op::OpUDotAccSat:
+    case spv::Op::OpSUDotAccSat:
+    case spv::Op::OpFDot2MixAcc32VALVE:
+    case spv::Op::OpFDot2MixAcc16VALVE:
+    case spv::Op::OpFDot4MixAcc32VALVE:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t DotProductPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
 
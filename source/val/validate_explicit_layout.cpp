@@ -137,6 +137,36 @@ struct Impl {
   // Caches valid results of CheckLayout calls.
   std::unordered_set<LayoutKey, LayoutKeyHash> layout_cache_;
 
+  // Key for the size and alignment caches.
+  struct TypeLayoutKey {
+    uint32_t type_id = 0;
+    LayoutMode layout;
+    MatrixConstraints matrix_constraints{};
+    bool allow_relaxed = true;
+
+    bool operator==(const TypeLayoutKey& other) const {
+      return type_id == other.type_id && layout == other.layout &&
+             matrix_constraints.stride == other.matrix_constraints.stride &&
+             matrix_constraints.col_major ==
+                 other.matrix_constraints.col_major &&
+             allow_relaxed == other.allow_relaxed;
+    }
+  };
+  struct TypeLayoutKeyHash {
+    size_t operator()(const TypeLayoutKey& key) const noexcept {
+      return spvtools::utils::hash_combine(
+          0, key.type_id, static_cast<uint32_t>(key.layout),
+          key.matrix_constraints.stride, key.matrix_constraints.col_major,
+          key.allow_relaxed);
+    }
+  };
+
+  // Caches of GetAlign and GetSize results. Deeply nested types are reached
+  // from many members and memory references, so each (type, rules) pair is
+  // only computed once.
+  std::unordered_map<TypeLayoutKey, uint32_t, TypeLayoutKeyHash> align_cache_;
+  std::unordered_map<TypeLayoutKey, uint32_t, TypeLayoutKeyHash> size_cache_;
+
   // Returns the layout requirements for `sc`.
   // Workgroup is expected to be explicitly laid out if `is_block` is true.
   // UniformConstant is expected to be explicitly laid out if `descriptor_heap`
@@ -370,28 +400,24 @@ struct Impl {
       }
     }
 
-    const auto& id_decs = vstate.id_decorations();
-    const auto iter = id_decs.find(type_id);
-    if (iter != id_decs.end()) {
-      for (const auto& d : iter->second) {
-        const spv::Decoration dec = d.dec_type();
-        if (dec == spv::Decoration::Block ||
-            dec == spv::Decoration::BufferBlock ||
-            dec == spv::Decoration::Offset ||
-            dec == spv::Decoration::OffsetIdEXT ||
-            dec == spv::Decoration::ArrayStride ||
-            dec == spv::Decoration::ArrayStrideIdEXT ||
-            dec == spv::Decoration::MatrixStride ||
-            dec == spv::Decoration::RowMajor ||
-            dec == spv::Decoration::ColMajor) {
-          return vstate.diag(SPV_ERROR_INVALID_ID, inst)
-                 << vstate.VkErrorID(10684)
-                 << "Invalid explicit layout decorations on type "
-                 << vstate.getIdName(type_id) << ", the "
-                 << spvtools::StorageClassToString(sc)
-                 << " storage class has an explicit layout from the "
-                 << vstate.SpvDecorationString(dec) << " decoration";
-        }
+    for (const auto& d : vstate.id_decorations(type_id)) {
+      const spv::Decoration dec = d.dec_type();
+      if (dec == spv::Decoration::Block ||
+          dec == spv::Decoration::BufferBlock ||
+          dec == spv::Decoration::Offset ||
+          dec == spv::Decoration::OffsetIdEXT ||
+          dec == spv::Decoration::ArrayStride ||
+          dec == spv::Decoration::ArrayStrideIdEXT ||
+          dec == spv::Decoration::MatrixStride ||
+          dec == spv::Decoration::RowMajor ||
+          dec == spv::Decoration::ColMajor) {
+        return vstate.diag(SPV_ERROR_INVALID_ID, inst)
+               << vstate.VkErrorID(10684)
+               << "Invalid explicit layout decorations on type "
+               << vstate.getIdName(type_id) << ", the "
+               << spvtools::StorageClassToString(sc)
+               << " storage class has an explicit layout from the "
+               << vstate.SpvDecorationString(dec) << " decoration";
       }
     }
 
@@ -521,6 +547,22 @@ struct Impl {
   uint32_t GetAlign(uint32_t type_id, LayoutMode mode,
                     const MatrixConstraints& matrix_constraints,
                     bool allow_relaxed = true) {
+    TypeLayoutKey key{type_id, mode, matrix_constraints, allow_relaxed};
+    auto iter = align_cache_.find(key);
+    if (iter != align_cache_.end()) {
+      return iter->second;
+    }
+    const uint32_t align =
+        ComputeAlign(type_id, mode, matrix_constraints, allow_relaxed);
+    align_cache_.emplace(key, align);
+    return align;
+  }
+
+  // Computes the alignment for type_id for the given layout rules. Nested
+  // types go through the cached GetAlign.
+  uint32_t ComputeAlign(uint32_t type_id, LayoutMode mode,
+                        const MatrixConstraints& matrix_constraints,
+                        bool allow_relaxed) {
     const auto* type_inst = vstate.FindDef(type_id);
     uint32_t align = 1;
     switch (type_inst->opcode()) {
@@ -617,6 +659,21 @@ struct Impl {
   // Returns the size of the given type.
   uint32_t GetSize(uint32_t type_id,
                    const MatrixConstraints& matrix_constraints) {
+    // The size does not depend on the layout rules.
+    TypeLayoutKey key{type_id, LayoutMode::kScalar, matrix_constraints, false};
+    auto iter = size_cache_.find(key);
+    if (iter != size_cache_.end()) {
+      return iter->second;
+    }
+    const uint32_t size = ComputeSize(type_id, matrix_constraints);
+    size_cache_.emplace(key, size);
+    return size;
+  }
+
+  // Computes the size of the given type. Nested types go through the cached
+  // GetSize.
+  uint32_t ComputeSize(uint32_t type_id,
+                       const MatrixConstraints& matrix_constraints) {
     const auto* type_inst = vstate.FindDef(type_id);
     switch (type_inst->opcode()) {
       case spv::Op::OpTypeSampledImage:
@@ -4478,6 +4478,11 @@ spv_result_t ValidateExtInst(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool ExtensionPassApplies(spv::Op opcode) {
+  return opcode == spv::Op::OpExtension || opcode == spv::Op::OpExtInstImport ||
+         spvIsExtendedInstruction(opcode);
+}
+
 spv_result_t ExtensionPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
   if (opcode == spv::Op::OpExtension) return ValidateExtension(_, inst);
@@ -381,6 +381,19 @@ spv_result_t ValidateCooperativeMatrixPerElementOp(ValidationState_t& _,
 
 }  // namespace
 
+bool FunctionPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpFunction:
+    case spv::Op::OpFunctionParameter:
+    case spv::Op::OpFunctionCall:
+    case spv::Op::OpCooperativeMatrixPerElementOpNV:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t FunctionPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpFunction:
@@ -558,6 +558,22 @@ spv_result_t ValidateGraphEnd(ValidationState_t& _, const Instruction* inst) {
 
 }  // namespace
 
+bool GraphPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpTypeGraphARM:
+    case spv::Op::OpGraphConstantARM:
+    case spv::Op::OpGraphEntryPointARM:
+    case spv::Op::OpGraphARM:
+    case spv::Op::OpGraphInputARM:
+    case spv::Op::OpGraphSetOutputARM:
+    case spv::Op::OpGraphEndARM:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of graph instructions.
 spv_result_t GraphPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
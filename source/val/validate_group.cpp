@@ -195,6 +195,28 @@ spv_result_t ValidateGroupWaitEvents(ValidationState_t& _,
 
 }  // namespace
 
+bool GroupPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpGroupAny:
+    case spv::Op::OpGroupAll:
+    case spv::Op::OpGroupBroadcast:
+    case spv::Op::OpGroupFAdd:
+    case spv::Op::OpGroupFMax:
+    case spv::Op::OpGroupFMin:
+    case spv::Op::OpGroupIAdd:
+    case spv::Op::OpGroupUMin:
+    case spv::Op::OpGroupSMin:
+    case spv::Op::OpGroupUMax:
+    case spv::Op::OpGroupSMax:
+    case spv::Op::OpGroupAsyncCopy:
+    case spv::Op::OpGroupWaitEvents:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t GroupPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
 
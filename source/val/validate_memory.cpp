@@ -38,8 +38,8 @@ bool HaveLayoutCompatibleMembers(ValidationState_t&, const Instruction*,
                                  const Instruction*);
 bool HaveSameLayoutDecorations(ValidationState_t&, const Instruction*,
                                const Instruction*);
-bool HasConflictingMemberOffsets(const std::set<Decoration>&,
-                                 const std::set<Decoration>&);
+bool HasConflictingMemberOffsets(const DecorationSet&,
+                                 const DecorationSet&);
 
 bool IsAllowedTypeOrArrayOfSame(ValidationState_t& _, const Instruction& type,
                                 std::initializer_list<spv::Op> allowed) {
@@ -108,8 +108,8 @@ bool HaveSameLayoutDecorations(ValidationState_t& _, const Instruction* type1,
          "type1 must be an OpTypeStruct instruction.");
   assert(type2->opcode() == spv::Op::OpTypeStruct &&
          "type2 must be an OpTypeStruct instruction.");
-  const std::set<Decoration>& type1_decorations = _.id_decorations(type1->id());
-  const std::set<Decoration>& type2_decorations = _.id_decorations(type2->id());
+  const DecorationSet& type1_decorations = _.id_decorations(type1->id());
+  const DecorationSet& type2_decorations = _.id_decorations(type2->id());
 
   // TODO: Will have to add other check for arrays an matricies if we want to
   // handle them.
@@ -121,8 +121,8 @@ bool HaveSameLayoutDecorations(ValidationState_t& _, const Instruction* type1,
 }
 
 bool HasConflictingMemberOffsets(
-    const std::set<Decoration>& type1_decorations,
-    const std::set<Decoration>& type2_decorations) {
+    const DecorationSet& type1_decorations,
+    const DecorationSet& type2_decorations) {
   {
     // We are interested in conflicting decoration.  If a decoration is in one
     // list but not the other, then we will assume the code is correct.  We are
@@ -3796,6 +3796,55 @@ spv_result_t ValidatePredicatedStoreINTEL(ValidationState_t& _,
 
 }  // namespace
 
+bool MemoryPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpVariable:
+    case spv::Op::OpUntypedVariableKHR:
+    case spv::Op::OpBufferPointerEXT:
+    case spv::Op::OpLoad:
+    case spv::Op::OpStore:
+    case spv::Op::OpCopyMemory:
+    case spv::Op::OpCopyMemorySized:
+    case spv::Op::OpPtrAccessChain:
+    case spv::Op::OpUntypedPtrAccessChainKHR:
+    case spv::Op::OpUntypedInBoundsPtrAccessChainKHR:
+    case spv::Op::OpAccessChain:
+    case spv::Op::OpInBoundsAccessChain:
+    case spv::Op::OpInBoundsPtrAccessChain:
+    case spv::Op::OpUntypedAccessChainKHR:
+    case spv::Op::OpUntypedInBoundsAccessChainKHR:
+    case spv::Op::OpRawAccessChainNV:
+    case spv::Op::OpArrayLength:
+    case spv::Op::OpUntypedArrayLengthKHR:
+    case spv::Op::OpCooperativeMatrixLoadNV:
+    case spv::Op::OpCooperativeMatrixStoreNV:
+    case spv::Op::OpCooperativeMatrixLengthKHR:
+    case spv::Op::OpCooperativeMatrixLengthNV:
+    case spv::Op::OpCooperativeMatrixLoadKHR:
+    case spv::Op::OpCooperativeMatrixStoreKHR:
+    case spv::Op::OpCooperativeMatrixLoadTensorNV:
+    case spv::Op::OpCooperativeMatrixStoreTensorNV:
+    case spv::Op::OpCooperativeVectorLoadNV:
+    case spv::Op::OpCooperativeVectorStoreNV:
+    case spv::Op::OpCooperativeVectorOuterProductAccumulateNV:
+    case spv::Op::OpCooperativeVectorReduceSumAccumulateNV:
+    case spv::Op::OpCooperativeVectorMatrixMulNV:
+    case spv::Op::OpCooperativeVectorMatrixMulAddNV:
+    case spv::Op::OpPredicatedLoadINTEL:
+    case spv::Op::OpPredicatedStoreINTEL:
+    case spv::Op::OpPtrEqual:
+    case spv::Op::OpPtrNotEqual:
+    case spv::Op::OpPtrDiff:
+    case spv::Op::OpImageTexelPointer:
+    case spv::Op::OpGenericPtrMemSemantics:
+    case spv::Op::OpSpecConstantOp:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t MemoryPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpVariable:
@@ -216,6 +216,19 @@ spv_result_t ValidateMeshVariable(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
+bool MeshShadingPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpEmitMeshTasksEXT:
+    case spv::Op::OpSetMeshOutputsEXT:
+    case spv::Op::OpVariable:
+    case spv::Op::OpWritePackedPrimitiveIndices4x8NV:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t MeshShadingPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
   switch (opcode) {
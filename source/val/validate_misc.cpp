@@ -130,6 +130,25 @@ spv_result_t ValidateAbort(ValidationState_t& _, const Instruction* inst) {
 
 }  // namespace
 
+bool MiscPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpUndef:
+    case spv::Op::OpPoisonKHR:
+    case spv::Op::OpBeginInvocationInterlockEXT:
+    case spv::Op::OpEndInvocationInterlockEXT:
+    case spv::Op::OpDemoteToHelperInvocationEXT:
+    case spv::Op::OpIsHelperInvocationEXT:
+    case spv::Op::OpReadClockKHR:
+    case spv::Op::OpAssumeTrueKHR:
+    case spv::Op::OpExpectKHR:
+    case spv::Op::OpAbortKHR:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t MiscPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpUndef:
@@ -1091,6 +1091,20 @@ spv_result_t ValidateFloatControls2(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
+bool ModeSettingPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpEntryPoint:
+    case spv::Op::OpExecutionMode:
+    case spv::Op::OpExecutionModeId:
+    case spv::Op::OpMemoryModel:
+    case spv::Op::OpCapability:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t ModeSettingPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpEntryPoint:
@@ -312,6 +312,32 @@ spv_result_t ValidateConstantPipeStorage(ValidationState_t& _,
 
 }  // namespace
 
+bool PipePassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpReadPipe:
+    case spv::Op::OpWritePipe:
+    case spv::Op::OpReservedReadPipe:
+    case spv::Op::OpReservedWritePipe:
+    case spv::Op::OpReserveReadPipePackets:
+    case spv::Op::OpReserveWritePipePackets:
+    case spv::Op::OpGroupReserveReadPipePackets:
+    case spv::Op::OpGroupReserveWritePipePackets:
+    case spv::Op::OpCommitReadPipe:
+    case spv::Op::OpCommitWritePipe:
+    case spv::Op::OpGroupCommitReadPipe:
+    case spv::Op::OpGroupCommitWritePipe:
+    case spv::Op::OpGetNumPipePackets:
+    case spv::Op::OpGetMaxPipePackets:
+    case spv::Op::OpIsValidReserveId:
+    case spv::Op::OpCreatePipeFromPipeStorage:
+    case spv::Op::OpConstantPipeStorage:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of pipe instructions.
 spv_result_t PipePass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
@@ -24,6 +24,19 @@
 namespace spvtools {
 namespace val {
 
+bool PrimitivesPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpEmitVertex:
+    case spv::Op::OpEndPrimitive:
+    case spv::Op::OpEmitStreamVertex:
+    case spv::Op::OpEndStreamPrimitive:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of primitive instructions.
 spv_result_t PrimitivesPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
@@ -78,6 +78,48 @@ spv_result_t ValidateIntersectionId(ValidationState_t& _,
 
 }  // namespace
 
+bool RayQueryPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpRayQueryInitializeKHR:
+    case spv::Op::OpRayQueryTerminateKHR:
+    case spv::Op::OpRayQueryConfirmIntersectionKHR:
+    case spv::Op::OpRayQueryGenerateIntersectionKHR:
+    case spv::Op::OpRayQueryGetIntersectionFrontFaceKHR:
+    case spv::Op::OpRayQueryProceedKHR:
+    case spv::Op::OpRayQueryGetIntersectionCandidateAABBOpaqueKHR:
+    case spv::Op::OpRayQueryGetIntersectionTKHR:
+    case spv::Op::OpRayQueryGetRayTMinKHR:
+    case spv::Op::OpRayQueryGetIntersectionTypeKHR:
+    case spv::Op::OpRayQueryGetIntersectionInstanceCustomIndexKHR:
+    case spv::Op::OpRayQueryGetIntersectionInstanceIdKHR:
+    case spv::Op::
+        OpRayQueryGetIntersectionInstanceShaderBindingTableRecordOffsetKHR:
+    case spv::Op::OpRayQueryGetIntersectionGeometryIndexKHR:
+    case spv::Op::OpRayQueryGetIntersectionPrimitiveIndexKHR:
+    case spv::Op::OpRayQueryGetRayFlagsKHR:
+    case spv::Op::OpRayQueryGetIntersectionObjectRayDirectionKHR:
+    case spv::Op::OpRayQueryGetIntersectionObjectRayOriginKHR:
+    case spv::Op::OpRayQueryGetWorldRayDirectionKHR:
+    case spv::Op::OpRayQueryGetWorldRayOriginKHR:
+    case spv::Op::OpRayQueryGetIntersectionBarycentricsKHR:
+    case spv::Op::OpRayQueryGetIntersectionObjectToWorldKHR:
+    case spv::Op::OpRayQueryGetIntersectionWorldToObjectKHR:
+    case spv::Op::OpRayQueryGetClusterIdNV:
+    case spv::Op::OpRayQueryGetIntersectionSpherePositionNV:
+    case spv::Op::OpRayQueryGetIntersectionLSSPositionsNV:
+    case spv::Op::OpRayQueryGetIntersectionLSSRadiiNV:
+    case spv::Op::OpRayQueryGetIntersectionSphereRadiusNV:
+    case spv::Op::OpRayQueryGetIntersectionLSSHitValueNV:
+    case spv::Op::OpRayQueryIsSphereHitNV:
+    case spv::Op::OpRayQueryIsLSSHitNV:
+    case spv::Op::OpRayQueryGetIntersectionTriangleVertexPositionsKHR:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t RayQueryPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
@@ -201,6 +201,18 @@ spv_result_t ValidateExecuteCallable(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
+bool RayTracingPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpTraceRayKHR:
+    case spv::Op::OpReportIntersectionKHR:
+    case spv::Op::OpExecuteCallableKHR:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t RayTracingPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
 
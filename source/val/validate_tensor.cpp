@@ -229,6 +229,18 @@ spv_result_t ValidateTensorQuerySize(ValidationState_t& _,
 
 }  // namespace
 
+bool TensorPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpTensorReadARM:
+    case spv::Op::OpTensorWriteARM:
+    case spv::Op::OpTensorQuerySizeARM:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 // Validates correctness of tensor instructions.
 spv_result_t TensorPass(ValidationState_t& _, const Instruction* inst) {
   (void)_;
@@ -141,6 +141,25 @@ spv_result_t ValidateTensorTypeWithDimValuesNV(ValidationState_t& _,
 
 }  // namespace
 
+bool TensorLayoutPassApplies(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpCreateTensorLayoutNV:
+    case spv::Op::OpCreateTensorViewNV:
+    case spv::Op::OpTensorLayoutSetBlockSizeNV:
+    case spv::Op::OpTensorLayoutSetDimensionNV:
+    case spv::Op::OpTensorLayoutSetStrideNV:
+    case spv::Op::OpTensorLayoutSliceNV:
+    case spv::Op::OpTensorLayoutSetClampValueNV:
+    case spv::Op::OpTensorViewSetDimensionNV:
+    case spv::Op::OpTensorViewSetStrideNV:
+    case spv::Op::OpTensorViewSetClipNV:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
 spv_result_t TensorLayoutPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpCreateTensorLayoutNV:
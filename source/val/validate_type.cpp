@@ -1102,11 +1102,13 @@ spv_result_t ValidateTypeBufferEXT(ValidationState_t& _,
 }
 }  // namespace
 
+bool TypePassApplies(spv::Op opcode) {
+  return spvOpcodeGeneratesType(opcode) ||
+         opcode == spv::Op::OpTypeForwardPointer;
+}
+
 spv_result_t TypePass(ValidationState_t& _, const Instruction* inst) {
-  if (!spvOpcodeGeneratesType(inst->opcode()) &&
-      inst->opcode() != spv::Op::OpTypeForwardPointer) {
-    return SPV_SUCCESS;
-  }
+  if (!TypePassApplies(inst->opcode())) return SPV_SUCCESS;
 
   if (auto error = ValidateUniqueness(_, inst)) return error;
 
@@ -17,6 +17,7 @@
 
 #include "source/val/validation_state.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <sstream>
@@ -249,12 +250,14 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
   }
   UpdateFeaturesBasedOnSpirvVersion(&features_, version_);
 
-  name_mapper_ = spvtools::GetTrivialNameMapper();
-  if (options_->use_friendly_names) {
+}
+
+spvtools::FriendlyNameMapper& ValidationState_t::GetFriendlyNameMapper() const {
+  if (!friendly_mapper_) {
     friendly_mapper_ = spvtools::MakeUnique<spvtools::FriendlyNameMapper>(
         context_, words_, num_words_);
-    name_mapper_ = friendly_mapper_->GetNameMapper();
   }
+  return *friendly_mapper_;
 }
 
 void ValidationState_t::preallocateStorage() {
@@ -286,7 +289,9 @@ void ValidationState_t::AssignNameToId(uint32_t id, std::string name) {
 }
 
 std::string ValidationState_t::getIdName(uint32_t id) const {
-  const std::string id_name = name_mapper_(id);
+  const std::string id_name = options_->use_friendly_names
+                                  ? GetFriendlyNameMapper().NameForId(id)
+                                  : std::to_string(id);
 
   std::stringstream out;
   out << "'" << id << "[%" << id_name << "]'";
@@ -354,16 +359,18 @@ DiagnosticStream ValidationState_t::diag(spv_result_t error_code,
     ++num_of_warnings_;
   }
 
-  std::string disassembly;
-  std::string shader_debug_info;
-  if (inst) {
-    disassembly = Disassemble(*inst);
-    shader_debug_info = InspectShaderDebugInfo(*inst);
+  if (!inst) {
+    return DiagnosticStream({0, 0, 0}, context_->consumer, "", error_code);
   }
 
-  return DiagnosticStream({0, 0, inst ? inst->LineNum() : 0},
-                          context_->consumer, disassembly, error_code,
-                          shader_debug_info);
+  // Rendering the instruction is only worth it if the message is emitted.
+  return DiagnosticStream(
+      {0, 0, inst->LineNum()}, context_->consumer,
+      [this, inst](std::string* disassembly, std::string* shader_debug_info) {
+        *disassembly = Disassemble(*inst);
+        *shader_debug_info = InspectShaderDebugInfo(*inst);
+      },
+      error_code);
 }
 
 std::vector<Function>& ValidationState_t::functions() {
@@ -2027,41 +2034,108 @@ const std::vector<uint32_t>& ValidationState_t::FunctionEntryPoints(
   }
 }
 
-std::set<uint32_t> ValidationState_t::EntryPointReferences(uint32_t id) const {
-  std::set<uint32_t> referenced_entry_points;
-  const auto inst = FindDef(id);
-  if (!inst) return referenced_entry_points;
-
-  std::vector<const Instruction*> stack;
-  stack.push_back(inst);
-  while (!stack.empty()) {
-    const auto current_inst = stack.back();
-    stack.pop_back();
-
-    if (const auto func = current_inst->function()) {
-      // Instruction lives in a function, we can stop searching.
-      const auto function_entry_points = FunctionEntryPoints(func->id());
-      referenced_entry_points.insert(function_entry_points.begin(),
-                                     function_entry_points.end());
-    } else {
-      // Instruction is in the global scope, keep searching its uses.
-      for (auto pair : current_inst->uses()) {
-        const auto next_inst = pair.first;
-        stack.push_back(next_inst);
+void ValidationState_t::ComputeEntryPointReferences() {
+  sorted_entry_points_ = entry_points_;
+  std::sort(sorted_entry_points_.begin(), sorted_entry_points_.end());
+  sorted_entry_points_.erase(
+      std::unique(sorted_entry_points_.begin(), sorted_entry_points_.end()),
+      sorted_entry_points_.end());
+  const auto num_entry_points =
+      static_cast<uint32_t>(sorted_entry_points_.size());
+  if (num_entry_points == 0) return;
+
+  auto get_bits = [this, num_entry_points](uint32_t id) -> utils::BitVector& {
+    return entry_point_references_
+        .emplace(id, utils::BitVector(num_entry_points))
+        .first->second;
+  };
+
+  // A function is used by the entry points that can call it.
+  for (const auto& pair : function_to_entry_points_) {
+    utils::BitVector& bits = get_bits(pair.first);
+    for (const uint32_t entry_point : pair.second) {
+      const auto it = std::lower_bound(sorted_entry_points_.begin(),
+                                       sorted_entry_points_.end(), entry_point);
+      bits.Set(static_cast<uint32_t>(it - sorted_entry_points_.begin()));
+    }
+  }
+
+  // A global id is used by the entry points of the functions that use it, and
+  // by the entry points that use the global ids that use it.  Record the
+  // former directly, and propagate along the latter with a worklist.  The
+  // global use graph can contain cycles through forward pointers, so a
+  // single pass in reverse module order is not enough.
+  std::unordered_map<uint32_t, std::vector<uint32_t>> global_users_to_used;
+  std::vector<uint32_t> worklist;
+  for (const auto& inst : ordered_instructions_) {
+    if (inst.function() || inst.id() == 0) continue;
+    for (const auto& use : inst.uses()) {
+      const Instruction* user = use.first;
+      if (const Function* func = user->function()) {
+        auto it = entry_point_references_.find(func->id());
+        if (it != entry_point_references_.end()) {
+          get_bits(inst.id()).Or(it->second);
+        }
+      } else if (user->id() != 0) {
+        global_users_to_used[user->id()].push_back(inst.id());
       }
     }
+    if (entry_point_references_.count(inst.id())) {
+      worklist.push_back(inst.id());
+    }
   }
 
-  return referenced_entry_points;
+  while (!worklist.empty()) {
+    const uint32_t user_id = worklist.back();
+    worklist.pop_back();
+    const auto used = global_users_to_used.find(user_id);
+    if (used == global_users_to_used.end()) continue;
+    const utils::BitVector& user_bits = entry_point_references_.at(user_id);
+    for (const uint32_t used_id : used->second) {
+      if (get_bits(used_id).Or(user_bits)) worklist.push_back(used_id);
+    }
+  }
+}
+
+ValidationState_t::EntryPointSet ValidationState_t::EntryPointReferences(
+    uint32_t id) const {
+  const utils::BitVector* bits = nullptr;
+  if (const auto inst = FindDef(id)) {
+    // An instruction in a function is used by the entry points that can call
+    // the function.
+    const uint32_t key = inst->function() ? inst->function()->id() : id;
+    const auto it = entry_point_references_.find(key);
+    if (it != entry_point_references_.end()) bits = &it->second;
+  }
+  return EntryPointSet(bits, &sorted_entry_points_);
 }
 
 std::string ValidationState_t::Disassemble(const Instruction& inst) const {
-  const spv_parsed_instruction_t& c_inst(inst.c_inst());
-  return Disassemble(c_inst.words, c_inst.num_words);
+  // The instruction has already been parsed, so it can be emitted directly,
+  // using the cached name mapper, instead of parsing the whole module again.
+  std::ostringstream stream;
+  disassemble::InstructionDisassembler disassembler(
+      stream,
+      SPV_BINARY_TO_TEXT_OPTION_NO_HEADER |
+          SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES,
+      GetFriendlyNameMapper().GetNameMapper());
+  disassembler.EmitInstruction(inst.c_inst(), 0);
+
+  std::string output = stream.str();
+  // Drop trailing newline characters.
+  while (!output.empty() && output.back() == '\n') output.pop_back();
+  return output;
 }
 
 std::string ValidationState_t::Disassemble(const uint32_t* words,
                                            uint16_t num_words) const {
+  for (const auto& inst : ordered_instructions_) {
+    if (inst.words().size() == num_words &&
+        std::equal(words, words + num_words, inst.words().begin())) {
+      return Disassemble(inst);
+    }
+  }
+
   uint32_t disassembly_options = SPV_BINARY_TO_TEXT_OPTION_NO_HEADER |
                                  SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
 
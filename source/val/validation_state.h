@@ -33,6 +33,7 @@
 #include "source/spirv_definition.h"
 #include "source/spirv_validator_options.h"
 #include "source/table2.h"
+#include "source/util/bit_vector.h"
 #include "source/val/decoration.h"
 #include "source/val/function.h"
 #include "source/val/instruction.h"
@@ -358,10 +359,70 @@ class ValidationState_t {
   /// Returns all the entry points that can call |func|.
   const std::vector<uint32_t>& FunctionEntryPoints(uint32_t func) const;
 
+  /// A read-only view of a set of entry points, stored as a bit set over the
+  /// indices of the distinct entry points of the module.  Iteration visits the
+  /// entry point ids in increasing order.  The view is valid as long as the
+  /// ValidationState_t it was obtained from.
+  class EntryPointSet {
+   public:
+    class const_iterator {
+     public:
+      uint32_t operator*() const { return (*set_->entry_points_)[index_]; }
+      const_iterator& operator++() {
+        index_ = set_->NextIndex(index_ + 1);
+        return *this;
+      }
+      bool operator==(const const_iterator& that) const {
+        return index_ == that.index_;
+      }
+      bool operator!=(const const_iterator& that) const {
+        return !(*this == that);
+      }
+
+     private:
+      friend class EntryPointSet;
+      const_iterator(const EntryPointSet* set, uint32_t index)
+          : set_(set), index_(index) {}
+
+      const EntryPointSet* set_;
+      uint32_t index_;
+    };
+
+    EntryPointSet(const utils::BitVector* bits,
+                  const std::vector<uint32_t>* entry_points)
+        : bits_(bits), entry_points_(entry_points) {}
+
+    bool empty() const { return bits_ == nullptr || bits_->Empty(); }
+    const_iterator begin() const { return const_iterator(this, NextIndex(0)); }
+    const_iterator end() const {
+      return const_iterator(this, static_cast<uint32_t>(entry_points_->size()));
+    }
+
+   private:
+    // Returns the first index, starting at |index|, of an entry point in the
+    // set, or the number of entry points if there is none.
+    uint32_t NextIndex(uint32_t index) const {
+      const auto size = static_cast<uint32_t>(entry_points_->size());
+      if (bits_ == nullptr) return size;
+      while (index < size && !bits_->Get(index)) ++index;
+      return index;
+    }
+
+    // The bits of the set, or null for the empty set.
+    const utils::BitVector* bits_;
+    // The distinct entry points of the module, in increasing order.
+    const std::vector<uint32_t>* entry_points_;
+  };
+
+  /// Computes, for every function and every global id, the set of entry points
+  /// that statically use it.
+  /// Note: called after ComputeFunctionToEntryPointMapping.
+  void ComputeEntryPointReferences();
+
   /// Returns all the entry points that statically use |id|.
   ///
-  /// Note: requires ComputeFunctionToEntryPointMapping to have been called.
-  std::set<uint32_t> EntryPointReferences(uint32_t id) const;
+  /// Note: requires ComputeEntryPointReferences to have been called.
+  EntryPointSet EntryPointReferences(uint32_t id) const;
 
   /// Inserts an <id> to the set of functions that are target of OpFunctionCall.
   void AddFunctionCallTarget(const uint32_t id) {
@@ -470,15 +531,13 @@ class ValidationState_t {
 
   /// Registers the decoration for the given <id>
   void RegisterDecorationForId(uint32_t id, const Decoration& dec) {
-    auto& dec_list = id_decorations_[id];
-    dec_list.insert(dec);
+    mutable_id_decorations(id).insert(dec);
   }
 
   /// Registers the list of decorations for the given <id>
   template <class InputIt>
   void RegisterDecorationsForId(uint32_t id, InputIt begin, InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[id];
-    cur_decs.insert(begin, end);
+    mutable_id_decorations(id).insert(begin, end);
   }
 
   /// Registers the list of decorations for the given member of the given
@@ -487,7 +546,7 @@ class ValidationState_t {
   void RegisterDecorationsForStructMember(uint32_t struct_id,
                                           uint32_t member_index, InputIt begin,
                                           InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[struct_id];
+    DecorationSet& cur_decs = mutable_id_decorations(struct_id);
     for (InputIt iter = begin; iter != end; ++iter) {
       Decoration dec = *iter;
       dec.set_struct_member_index(member_index);
@@ -496,20 +555,20 @@ class ValidationState_t {
   }
 
   /// Returns all the decorations for the given <id>. If no decorations exist
-  /// for the <id>, it registers an empty set for it in the map and
-  /// returns the empty set.
-  std::set<Decoration>& id_decorations(uint32_t id) {
-    return id_decorations_[id];
+  /// for the <id>, returns an empty set.
+  const DecorationSet& id_decorations(uint32_t id) const {
+    return id < id_decorations_.size() ? id_decorations_[id]
+                                       : empty_decorations_;
   }
 
   /// Returns the range of decorations for the given field of the given <id>.
   struct FieldDecorationsIter {
-    std::set<Decoration>::const_iterator begin;
-    std::set<Decoration>::const_iterator end;
+    DecorationSet::const_iterator begin;
+    DecorationSet::const_iterator end;
   };
   FieldDecorationsIter id_member_decorations(uint32_t id,
-                                             uint32_t member_index) {
-    const auto& decorations = id_decorations_[id];
+                                             uint32_t member_index) const {
+    const auto& decorations = id_decorations(id);
 
     // The decorations are sorted by member_index, so this look up will give the
     // exact range of decorations for this member index.
@@ -523,20 +582,16 @@ class ValidationState_t {
     return result;
   }
 
-  // Returns const pointer to the internal decoration container.
-  const std::map<uint32_t, std::set<Decoration>>& id_decorations() const {
+  /// Returns the decorations of all <id>s, indexed by <id>.  <id>s past the
+  /// end of the table have no decorations.
+  const std::vector<DecorationSet>& id_decorations() const {
     return id_decorations_;
   }
 
   /// Returns true if the given id <id> has the given decoration <dec>,
   /// otherwise returns false.
-  bool HasDecoration(uint32_t id, spv::Decoration dec) {
-    const auto& decorations = id_decorations_.find(id);
-    if (decorations == id_decorations_.end()) return false;
-
-    return std::any_of(
-        decorations->second.begin(), decorations->second.end(),
-        [dec](const Decoration& d) { return dec == d.dec_type(); });
+  bool HasDecoration(uint32_t id, spv::Decoration dec) const {
+    return id_decorations(id).HasType(dec);
   }
 
   /// Returns true if the given id <id> has the given built-in decoration <bt>,
@@ -921,9 +976,13 @@ class ValidationState_t {
   // Returns the disassembly string for the given instruction.
   std::string Disassemble(const Instruction& inst) const;
 
-  // Returns the disassembly string for the given instruction.
+  // Returns the disassembly string for the given instruction.  This is cheaper
+  // if the words are those of an instruction that has already been registered.
   std::string Disassemble(const uint32_t* words, uint16_t num_words) const;
 
+  // Returns the friendly name mapper for the module, building it on first use.
+  spvtools::FriendlyNameMapper& GetFriendlyNameMapper() const;
+
   // Returns the string name for |decoration|.
   std::string SpvDecorationString(uint32_t decoration) {
     const spvtools::OperandDesc* desc = nullptr;
@@ -1109,7 +1168,7 @@ class ValidationState_t {
   std::unordered_set<uint32_t> function_call_targets_;
 
   /// ID Bound from the Header
-  uint32_t id_bound_;
+  uint32_t id_bound_ = 0;
 
   /// Set of Global Variable IDs (Storage Class other than 'Function')
   std::unordered_set<uint32_t> global_vars_;
@@ -1127,8 +1186,26 @@ class ValidationState_t {
   std::unordered_map<uint32_t, bool>
       struct_has_nested_blockorbufferblock_struct_;
 
-  /// Stores the list of decorations for a given <id>
-  std::map<uint32_t, std::set<Decoration>> id_decorations_;
+  /// Returns the decorations of |id| for modification, growing the table if
+  /// needed.  The table only covers the decorated <id>s: it grows
+  /// geometrically, without going past the id bound, so that modules with a
+  /// large bound and few decorations stay small.  Growing the table
+  /// invalidates the references returned by id_decorations().
+  DecorationSet& mutable_id_decorations(uint32_t id) {
+    if (id >= id_decorations_.size()) {
+      const size_t doubled = 2 * id_decorations_.size();
+      const size_t limit = std::max<size_t>(id + 1, id_bound_);
+      id_decorations_.resize(
+          std::max<size_t>(id + 1, std::min(doubled, limit)));
+    }
+    return id_decorations_[id];
+  }
+
+  /// Stores the set of decorations for each <id>, indexed by <id>.
+  std::vector<DecorationSet> id_decorations_;
+
+  /// The set of decorations of <id>s that have none.
+  const DecorationSet empty_decorations_;
 
   /// Stores type declarations which need to be unique (i.e. non-aggregates),
   /// in the form [opcode, operand words], result_id is not stored.
@@ -1188,6 +1265,14 @@ class ValidationState_t {
   std::unordered_map<uint32_t, std::vector<uint32_t>> function_to_entry_points_;
   const std::vector<uint32_t> empty_ids_;
 
+  /// The distinct entry points of the module, in increasing order.  The bits
+  /// of |entry_point_references_| are indices into this vector.
+  std::vector<uint32_t> sorted_entry_points_;
+
+  /// Mapping function or global id -> set of entry points that statically use
+  /// it.  Ids used by no entry point may be missing.
+  std::unordered_map<uint32_t, utils::BitVector> entry_point_references_;
+
   // The IDs of types of pointers to Block-decorated structs in Uniform storage
   // class. This is populated at the start of ValidateDecorations.
   std::unordered_set<uint32_t> pointer_to_uniform_block_;
@@ -1216,9 +1301,9 @@ class ValidationState_t {
   // to know to try and print out a source line on an error message
   uint32_t shader_debug_info_set_id = 0;
 
-  /// Maps ids to friendly names.
-  std::unique_ptr<spvtools::FriendlyNameMapper> friendly_mapper_;
-  spvtools::NameMapper name_mapper_;
+  /// Maps ids to friendly names.  Created on first use, since building it
+  /// parses the whole module.  See GetFriendlyNameMapper().
+  mutable std::unique_ptr<spvtools::FriendlyNameMapper> friendly_mapper_;
 
   /// Variables used to reduce the number of diagnostic messages.
   uint32_t num_of_warnings_;
@@ -0,0 +1,391 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// spirv-tools-bench: micro and macro benchmarks for the assembler, the
+// disassembler, the binary parser, the validator, the optimizer, the linker
+// and the differ, run on synthetic modules from the corpus generator.
+//
+// Results are written as JSON by default so that they can be archived and
+// compared across releases. All google-benchmark flags are accepted, e.g.
+// --benchmark_filter=<regex> or --benchmark_format=console.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "source/diff/diff.h"
+#include "source/opt/build_module.h"
+#include "source/opt/ir_context.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/linker.hpp"
+#include "spirv-tools/optimizer.hpp"
+#include "tools/bench/corpus.h"
+#include "tools/io.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+constexpr spv_target_env kDefaultEnvironment = SPV_ENV_UNIVERSAL_1_6;
+
+// Number of functions in the corpus modules used by every benchmark.
+const std::vector<int64_t> kCorpusSizes = {16, 128, 1024};
+
+// Number of libraries combined by the link benchmark.
+constexpr uint32_t kNumLinkedModules = 8;
+
+// The optimization passes benchmarked in isolation.
+const char* const kPassFlags[] = {
+    "--ccp",
+    "--eliminate-dead-branches",
+    "--eliminate-dead-code-aggressive",
+    "--eliminate-dead-functions",
+    "--eliminate-local-multi-store",
+    "--eliminate-local-single-block",
+    "--eliminate-local-single-store",
+    "--if-conversion",
+    "--inline-entry-points-exhaustive",
+    "--loop-unroll",
+    "--merge-blocks",
+    "--redundancy-elimination",
+    "--scalar-replacement",
+    "--simplify-instructions",
+};
+
+void IgnoreMessages(spv_message_level_t, const char*, const spv_position_t&,
+                    const char*) {}
+
+// Returns the options for a corpus module with |num_functions| functions.
+CorpusOptions CorpusFor(int64_t num_functions) {
+  CorpusOptions options;
+  options.num_functions = static_cast<uint32_t>(num_functions);
+  return options;
+}
+
+// Returns the assembly text of the corpus module with |num_functions|
+// functions. Modules are generated once and shared by all benchmarks.
+const std::string& CorpusText(int64_t num_functions) {
+  static std::map<int64_t, std::string> cache;
+  auto iter = cache.find(num_functions);
+  if (iter == cache.end()) {
+    iter = cache
+               .emplace(num_functions,
+                        GenerateModuleText(CorpusFor(num_functions)))
+               .first;
+  }
+  return iter->second;
+}
+
+// Returns the binary of the corpus module with |num_functions| functions.
+const std::vector<uint32_t>& CorpusBinary(int64_t num_functions) {
+  static std::map<int64_t, std::vector<uint32_t>> cache;
+  auto iter = cache.find(num_functions);
+  if (iter == cache.end()) {
+    std::vector<uint32_t> binary;
+    SpirvTools tools(kDefaultEnvironment);
+    if (!tools.Assemble(CorpusText(num_functions), &binary)) {
+      fprintf(stderr, "error: failed to assemble the corpus module\n");
+      exit(1);
+    }
+    // The benchmarks assume a valid module: fail loudly rather than let them
+    // skip or time error paths.
+    tools.SetMessageConsumer([](spv_message_level_t, const char*,
+                                const spv_position_t&, const char* message) {
+      fprintf(stderr, "error: %s\n", message);
+    });
+    if (!tools.Validate(binary)) {
+      fprintf(stderr, "error: the corpus module is invalid\n");
+      exit(1);
+    }
+    iter = cache.emplace(num_functions, std::move(binary)).first;
+  }
+  return iter->second;
+}
+
+void SetBytesProcessed(benchmark::State& state, size_t bytes_per_iteration) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(bytes_per_iteration));
+}
+
+void BM_Assemble(benchmark::State& state) {
+  const std::string& text = CorpusText(state.range(0));
+  SpirvTools tools(kDefaultEnvironment);
+  std::vector<uint32_t> binary;
+  for (auto _ : state) {
+    binary.clear();
+    if (!tools.Assemble(text, &binary)) {
+      state.SkipWithError("assembly failed");
+      break;
+    }
+    benchmark::DoNotOptimize(binary.data());
+  }
+  SetBytesProcessed(state, text.size());
+}
+
+void BM_Disassemble(benchmark::State& state) {
+  const std::vector<uint32_t>& binary = CorpusBinary(state.range(0));
+  SpirvTools tools(kDefaultEnvironment);
+  std::string text;
+  for (auto _ : state) {
+    text.clear();
+    if (!tools.Disassemble(binary, &text)) {
+      state.SkipWithError("disassembly failed");
+      break;
+    }
+    benchmark::DoNotOptimize(text.data());
+  }
+  SetBytesProcessed(state, binary.size() * sizeof(uint32_t));
+}
+
+void BM_Parse(benchmark::State& state) {
+  const std::vector<uint32_t>& binary = CorpusBinary(state.range(0));
+  spv_context context = spvContextCreate(kDefaultEnvironment);
+  size_t num_instructions = 0;
+  auto count_instruction = [](void* user_data,
+                              const spv_parsed_instruction_t*) {
+    ++*static_cast<size_t*>(user_data);
+    return SPV_SUCCESS;
+  };
+  for (auto _ : state) {
+    num_instructions = 0;
+    if (spvBinaryParse(context, &num_instructions, binary.data(),
+                       binary.size(), nullptr, count_instruction,
+                       nullptr) != SPV_SUCCESS) {
+      state.SkipWithError("parse failed");
+      break;
+    }
+  }
+  spvContextDestroy(context);
+  SetBytesProcessed(state, binary.size() * sizeof(uint32_t));
+  state.counters["instructions"] = static_cast<double>(num_instructions);
+}
+
+void BM_Validate(benchmark::State& state) {
+  const std::vector<uint32_t>& binary = CorpusBinary(state.range(0));
+  SpirvTools tools(kDefaultEnvironment);
+  tools.SetMessageConsumer(IgnoreMessages);
+  for (auto _ : state) {
+    if (!tools.Validate(binary)) {
+      state.SkipWithError("validation failed");
+      break;
+    }
+  }
+  SetBytesProcessed(state, binary.size() * sizeof(uint32_t));
+}
+
+// Runs |register_passes| on a fresh optimizer for every iteration. The time
+// includes building the IR from the binary, which every optimizer run pays.
+template <typename RegisterPasses>
+void RunOptimizer(benchmark::State& state, RegisterPasses register_passes) {
+  const std::vector<uint32_t>& binary = CorpusBinary(state.range(0));
+  OptimizerOptions options;
+  options.set_run_validator(false);
+  std::vector<uint32_t> optimized;
+  for (auto _ : state) {
+    Optimizer optimizer(kDefaultEnvironment);
+    optimizer.SetMessageConsumer(IgnoreMessages);
+    if (!register_passes(&optimizer)) {
+      state.SkipWithError("unknown pass");
+      break;
+    }
+    optimized.clear();
+    if (!optimizer.Run(binary.data(), binary.size(), &optimized, options)) {
+      state.SkipWithError("optimization failed");
+      break;
+    }
+    benchmark::DoNotOptimize(optimized.data());
+  }
+  SetBytesProcessed(state, binary.size() * sizeof(uint32_t));
+  state.counters["output_words"] = static_cast<double>(optimized.size());
+}
+
+void BM_OptimizePass(benchmark::State& state, const std::string& flag) {
+  RunOptimizer(state, [&flag](Optimizer* optimizer) {
+    return optimizer->RegisterPassFromFlag(flag);
+  });
+}
+
+void BM_OptimizePerformance(benchmark::State& state) {
+  RunOptimizer(state, [](Optimizer* optimizer) {
+    optimizer->RegisterPerformancePasses();
+    return true;
+  });
+}
+
+void BM_OptimizeSize(benchmark::State& state) {
+  RunOptimizer(state, [](Optimizer* optimizer) {
+    optimizer->RegisterSizePasses();
+    return true;
+  });
+}
+
+void BM_Link(benchmark::State& state) {
+  std::vector<std::vector<uint32_t>> libraries(kNumLinkedModules);
+  size_t total_words = 0;
+  for (uint32_t i = 0; i < kNumLinkedModules; ++i) {
+    CorpusOptions options = CorpusFor(state.range(0));
+    options.library = true;
+    options.symbol_prefix = "lib" + std::to_string(i) + "_f";
+    if (!GenerateModule(options, kDefaultEnvironment, &libraries[i])) {
+      state.SkipWithError("failed to generate the corpus libraries");
+      return;
+    }
+    total_words += libraries[i].size();
+  }
+
+  Context context(kDefaultEnvironment);
+  context.SetMessageConsumer(IgnoreMessages);
+  LinkerOptions options;
+  options.SetCreateLibrary(true);
+  std::vector<uint32_t> linked;
+  for (auto _ : state) {
+    linked.clear();
+    if (Link(context, libraries, &linked, options) != SPV_SUCCESS) {
+      state.SkipWithError("link failed");
+      break;
+    }
+    benchmark::DoNotOptimize(linked.data());
+  }
+  SetBytesProcessed(state, total_words * sizeof(uint32_t));
+}
+
+void BM_Diff(benchmark::State& state) {
+  const std::vector<uint32_t>& src_binary = CorpusBinary(state.range(0));
+
+  // Diff the module against its optimized form, so that the differ has to
+  // match functions whose bodies changed.
+  std::vector<uint32_t> dst_binary;
+  Optimizer optimizer(kDefaultEnvironment);
+  optimizer.SetMessageConsumer(IgnoreMessages);
+  optimizer.RegisterPerformancePasses();
+  if (!optimizer.Run(src_binary.data(), src_binary.size(), &dst_binary)) {
+    state.SkipWithError("failed to optimize the corpus module");
+    return;
+  }
+
+  diff::Options options;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<opt::IRContext> src =
+        BuildModule(kDefaultEnvironment, IgnoreMessages, src_binary.data(),
+                    src_binary.size());
+    std::unique_ptr<opt::IRContext> dst =
+        BuildModule(kDefaultEnvironment, IgnoreMessages, dst_binary.data(),
+                    dst_binary.size());
+    std::ostringstream out;
+    state.ResumeTiming();
+    if (diff::Diff(src.get(), dst.get(), out, options) != SPV_SUCCESS) {
+      state.SkipWithError("diff failed");
+      break;
+    }
+  }
+}
+
+void RegisterBenchmarks() {
+  auto add = [](benchmark::internal::Benchmark* benchmark) {
+    for (int64_t size : kCorpusSizes) benchmark->Arg(size);
+    benchmark->ArgName("functions")->Unit(benchmark::kMicrosecond);
+  };
+
+  add(benchmark::RegisterBenchmark("Assemble", BM_Assemble));
+  add(benchmark::RegisterBenchmark("Disassemble", BM_Disassemble));
+  add(benchmark::RegisterBenchmark("Parse", BM_Parse));
+  add(benchmark::RegisterBenchmark("Validate", BM_Validate));
+  for (const char* flag : kPassFlags) {
+    const std::string name = std::string("OptimizePass/") + (flag + 2);
+    add(benchmark::RegisterBenchmark(name.c_str(), BM_OptimizePass,
+                                     std::string(flag)));
+  }
+  add(benchmark::RegisterBenchmark("Optimize/-O", BM_OptimizePerformance));
+  add(benchmark::RegisterBenchmark("Optimize/-Os", BM_OptimizeSize));
+  add(benchmark::RegisterBenchmark("Link", BM_Link));
+  add(benchmark::RegisterBenchmark("Diff", BM_Diff));
+}
+
+// Writes the corpus modules to |directory| as corpus_<functions>.spv, so that
+// they can be fed to the command line tools.
+bool WriteCorpus(const std::string& directory) {
+  for (int64_t size : kCorpusSizes) {
+    const std::vector<uint32_t>& binary = CorpusBinary(size);
+    const std::string filename =
+        directory + "/corpus_" + std::to_string(size) + ".spv";
+    if (!WriteFile<uint32_t>(filename.c_str(), "wb", binary.data(),
+                             binary.size())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PrintUsage(const char* program) {
+  printf(
+      R"(%s - Benchmark the SPIR-V Tools on synthetic modules.
+
+USAGE: %s [options] [benchmark options]
+
+Options:
+  --write-corpus=<dir>
+               Write the corpus modules to <dir> and exit.
+  -h, --help   Print this help.
+
+Results are printed as JSON unless --benchmark_format is given. All other
+options are forwarded to google-benchmark; see --benchmark_help.
+)",
+      program, program);
+}
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
+
+int main(int argc, char** argv) {
+  std::vector<char*> args;
+  args.push_back(argv[0]);
+  bool has_format = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* cur_arg = argv[i];
+    if (0 == strcmp(cur_arg, "--help") || 0 == strcmp(cur_arg, "-h")) {
+      spvtools::bench::PrintUsage(argv[0]);
+      return 0;
+    } else if (0 == strncmp(cur_arg, "--write-corpus=", 15)) {
+      return spvtools::bench::WriteCorpus(cur_arg + 15) ? 0 : 1;
+    } else {
+      if (0 == strncmp(cur_arg, "--benchmark_format=", 19)) has_format = true;
+      args.push_back(argv[i]);
+    }
+  }
+
+  // Default to machine readable output, for tracking regressions.
+  static char json_format[] = "--benchmark_format=json";
+  if (!has_format) args.push_back(json_format);
+
+  int benchmark_argc = static_cast<int>(args.size());
+  benchmark::Initialize(&benchmark_argc, args.data());
+  if (benchmark::ReportUnrecognizedArguments(benchmark_argc, args.data())) {
+    return 1;
+  }
+  benchmark::AddCustomContext("spirv-tools",
+                              spvSoftwareVersionDetailsString());
+  spvtools::bench::RegisterBenchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
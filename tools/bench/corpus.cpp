@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tools/bench/corpus.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "spirv-tools/libspirv.hpp"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// Number of small integer constants %int_0 ... %int_<kNumConstants - 1>.
+constexpr uint32_t kNumConstants = 8;
+
+// Number of iterations of the loop in every function.
+constexpr uint32_t kLoopTripCount = 10;
+
+// Emits the straight-line arithmetic of the loop body of function |f|. The
+// chain reads and writes %f<f>_acc, and every third instruction recomputes an
+// earlier expression so that redundancy elimination has work to do.
+void EmitArithmetic(std::ostream& out, uint32_t f, uint32_t count) {
+  static const char* const kOps[] = {"OpIAdd", "OpIMul", "OpISub",
+                                     "OpBitwiseXor"};
+  const std::string prefix = "%f" + std::to_string(f) + "_a";
+  out << prefix << "0 = OpLoad %int %f" << f << "_acc\n";
+  for (uint32_t i = 1; i <= count; ++i) {
+    out << prefix << i << " = ";
+    if (i % 3 == 0) {
+      // Same expression as instruction i - 2.
+      out << kOps[(i - 2) % 4] << " %int " << prefix << (i - 3) << " %int_"
+          << (i - 2) % kNumConstants << "\n";
+    } else {
+      out << kOps[i % 4] << " %int " << prefix << (i - 1) << " %int_"
+          << i % kNumConstants << "\n";
+    }
+  }
+  out << "OpStore %f" << f << "_acc " << prefix << count << "\n";
+}
+
+// Emits function |f|, which takes and returns an int.
+void EmitFunction(std::ostream& out, const CorpusOptions& options,
+                  uint32_t f) {
+  const std::string p = "%f" + std::to_string(f);
+  out << p << " = OpFunction %int None %int_fn\n";
+  out << p << "_x = OpFunctionParameter %int\n";
+  out << p << "_entry = OpLabel\n";
+  out << p << "_acc = OpVariable %ptr_int Function\n";
+  out << p << "_it = OpVariable %ptr_int Function\n";
+  out << "OpStore " << p << "_acc " << p << "_x\n";
+  out << "OpStore " << p << "_it %int_0\n";
+  out << "OpBranch " << p << "_header\n";
+
+  // Loop header and condition.
+  out << p << "_header = OpLabel\n";
+  out << "OpLoopMerge " << p << "_merge " << p << "_continue None\n";
+  out << "OpBranch " << p << "_cond\n";
+  out << p << "_cond = OpLabel\n";
+  out << p << "_n = OpLoad %int " << p << "_it\n";
+  out << p << "_c = OpSLessThan %bool " << p << "_n %int_trip\n";
+  out << "OpBranchConditional " << p << "_c " << p << "_body " << p
+      << "_merge\n";
+
+  // Loop body: arithmetic followed by an if/else diamond.
+  out << p << "_body = OpLabel\n";
+  EmitArithmetic(out, f, options.instructions_per_block);
+  out << p << "_v = OpLoad %int " << p << "_acc\n";
+  out << p << "_odd = OpBitwiseAnd %int " << p << "_v %int_1\n";
+  out << p << "_is_odd = OpIEqual %bool " << p << "_odd %int_1\n";
+  out << "OpSelectionMerge " << p << "_sel_merge None\n";
+  out << "OpBranchConditional " << p << "_is_odd " << p << "_then " << p
+      << "_else\n";
+  out << p << "_then = OpLabel\n";
+  out << p << "_t = OpIAdd %int " << p << "_v %int_3\n";
+  out << "OpStore " << p << "_acc " << p << "_t\n";
+  out << "OpBranch " << p << "_sel_merge\n";
+  out << p << "_else = OpLabel\n";
+  out << p << "_e = OpISub %int " << p << "_v %int_1\n";
+  out << "OpStore " << p << "_acc " << p << "_e\n";
+  out << "OpBranch " << p << "_sel_merge\n";
+  out << p << "_sel_merge = OpLabel\n";
+  out << "OpBranch " << p << "_continue\n";
+
+  // Continue target.
+  out << p << "_continue = OpLabel\n";
+  out << p << "_n2 = OpLoad %int " << p << "_it\n";
+  out << p << "_n3 = OpIAdd %int " << p << "_n2 %int_1\n";
+  out << "OpStore " << p << "_it " << p << "_n3\n";
+  out << "OpBranch " << p << "_header\n";
+
+  // Exit: chain to the previous function.
+  out << p << "_merge = OpLabel\n";
+  out << p << "_r = OpLoad %int " << p << "_acc\n";
+  if (f > 0) {
+    out << p << "_call = OpFunctionCall %int %f" << (f - 1) << " " << p
+        << "_r\n";
+    out << "OpReturnValue " << p << "_call\n";
+  } else {
+    out << "OpReturnValue " << p << "_r\n";
+  }
+  out << "OpFunctionEnd\n";
+}
+
+}  // namespace
+
+std::string GenerateModuleText(const CorpusOptions& options) {
+  const uint32_t num_functions = std::max(1u, options.num_functions);
+  std::ostringstream out;
+  out << "OpCapability Shader\n";
+  if (options.library) out << "OpCapability Linkage\n";
+  out << "OpMemoryModel Logical GLSL450\n";
+  if (!options.library) {
+    // SPIR-V 1.4 and later require the interface to list every global
+    // variable that the entry point uses.
+    out << "OpEntryPoint GLCompute %main \"main\" %result\n";
+    out << "OpExecutionMode %main LocalSize 1 1 1\n";
+  } else {
+    for (uint32_t f = 0; f < num_functions; ++f) {
+      out << "OpDecorate %f" << f << " LinkageAttributes \""
+          << options.symbol_prefix << f << "\" Export\n";
+    }
+  }
+
+  out << "%void = OpTypeVoid\n";
+  out << "%void_fn = OpTypeFunction %void\n";
+  out << "%bool = OpTypeBool\n";
+  out << "%int = OpTypeInt 32 1\n";
+  out << "%int_fn = OpTypeFunction %int %int\n";
+  out << "%ptr_int = OpTypePointer Function %int\n";
+  out << "%ptr_private_int = OpTypePointer Private %int\n";
+  for (uint32_t i = 0; i < kNumConstants; ++i) {
+    out << "%int_" << i << " = OpConstant %int " << i << "\n";
+  }
+  out << "%int_trip = OpConstant %int " << kLoopTripCount << "\n";
+  out << "%result = OpVariable %ptr_private_int Private\n";
+
+  for (uint32_t f = 0; f < num_functions; ++f) {
+    EmitFunction(out, options, f);
+  }
+
+  if (!options.library) {
+    out << "%main = OpFunction %void None %void_fn\n";
+    out << "%main_entry = OpLabel\n";
+    out << "%main_r = OpFunctionCall %int %f" << (num_functions - 1)
+        << " %int_1\n";
+    out << "OpStore %result %main_r\n";
+    out << "OpReturn\n";
+    out << "OpFunctionEnd\n";
+  }
+  return out.str();
+}
+
+bool GenerateModule(const CorpusOptions& options, spv_target_env env,
+                    std::vector<uint32_t>* binary) {
+  SpirvTools tools(env);
+  return tools.Assemble(GenerateModuleText(options), binary,
+                        SPV_TEXT_TO_BINARY_OPTION_NONE) &&
+         tools.Validate(*binary);
+}
+
+}  // namespace bench
+}  // namespace spvtools
@@ -0,0 +1,58 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLS_BENCH_CORPUS_H_
+#define TOOLS_BENCH_CORPUS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "spirv-tools/libspirv.h"
+
+namespace spvtools {
+namespace bench {
+
+// Shape of a synthetic module produced by the corpus generator.
+struct CorpusOptions {
+  // Number of functions in the module. Each function holds a loop containing
+  // a straight-line arithmetic block and an if/else diamond, and calls the
+  // previous function.
+  uint32_t num_functions = 64;
+  // Number of arithmetic instructions in the body of each loop.
+  uint32_t instructions_per_block = 16;
+  // If true, the module is a library: it declares the Linkage capability,
+  // exports every function and has no entry point. Otherwise, the module is a
+  // GLCompute shader whose entry point calls the last function.
+  bool library = false;
+  // Prefix of the exported function names of a library, so that several
+  // libraries can be linked together.
+  std::string symbol_prefix = "f";
+};
+
+// Returns the assembly text of a synthetic module shaped by |options|, valid
+// for SPIR-V 1.4 and later. The module uses function-scope variables, loops,
+// selections, redundant expressions and calls so that the major optimization
+// passes have work to do.
+std::string GenerateModuleText(const CorpusOptions& options);
+
+// Assembles the module described by |options| for |env| into |binary| and
+// validates it. Returns false if assembly or validation fails.
+bool GenerateModule(const CorpusOptions& options, spv_target_env env,
+                    std::vector<uint32_t>* binary);
+
+}  // namespace bench
+}  // namespace spvtools
+
+#endif  // TOOLS_BENCH_CORPUS_H_
@@ -167,8 +167,8 @@ int main(int, const char** argv) {
   }
 
   // Read the input binary.
-  std::vector<uint32_t> contents;
-  if (!ReadBinaryFile(inFile.c_str(), &contents)) return 1;
+  BinaryInput contents;
+  if (!ReadBinaryInput(inFile.c_str(), &contents)) return 1;
 
   // If printing to standard output, then spvBinaryToText should
   // do the printing.  In particular, colour printing on Windows is
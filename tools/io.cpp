@@ -16,8 +16,11 @@
 
 #include <assert.h>
 #include <ctype.h>
+#include <stdarg.h>
 #include <stdlib.h>
 
+#include <string>
+
 #if defined(SPIRV_WINDOWS)
 #include <fcntl.h>
 #include <io.h>
@@ -35,7 +38,36 @@
 #define SET_STDOUT_MODE(mode)
 #endif
 
+// Input files are mapped into memory on the platforms that support it.
+#if defined(SPIRV_WINDOWS)
+#include <windows.h>
+#define SPIRV_MAP_INPUT_FILES
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPIRV_MAP_INPUT_FILES
+#endif
+
 namespace {
+// Reports an error formatted from |format|: appends it as a line to |error|
+// if it is not null, and writes it to standard error otherwise.
+void ReportError(std::string* error, const char* format, ...) {
+  char message[1024];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+  if (error == nullptr) {
+    fprintf(stderr, "error: %s\n", message);
+    return;
+  }
+  if (!error->empty()) *error += '\n';
+  *error += "error: ";
+  *error += message;
+}
+
 // Appends the contents of the |file| to |data|, assuming each element in the
 // file is of type |T|.
 template <typename T>
@@ -50,16 +82,17 @@ void ReadFile(FILE* file, std::vector<T>* data) {
 }
 
 // Returns true if |file| has encountered an error opening the file or reading
-// from it. If there was an error, writes an error message to standard error.
-bool WasFileCorrectlyRead(FILE* file, const char* filename) {
+// from it. If there was an error, reports it through |error|.
+bool WasFileCorrectlyRead(FILE* file, const char* filename,
+                          std::string* error) {
   if (file == nullptr) {
-    fprintf(stderr, "error: file does not exist '%s'\n", filename);
+    ReportError(error, "file does not exist '%s'", filename);
     return false;
   }
 
   if (ftell(file) == -1L) {
     if (ferror(file)) {
-      fprintf(stderr, "error: error reading file '%s'\n", filename);
+      ReportError(error, "error reading file '%s'", filename);
       return false;
     }
   }
@@ -67,14 +100,14 @@ bool WasFileCorrectlyRead(FILE* file, const char* filename) {
 }
 
 // Ensure the file contained an exact number of elements, whose size is given in
-// |alignment|.
+// |alignment|. Otherwise, reports an error through |error|.
 bool WasFileSizeAligned(const char* filename, size_t read_size,
-                        size_t alignment) {
+                        size_t alignment, std::string* error) {
   assert(alignment != 1);
   if ((read_size % alignment) != 0) {
-    fprintf(stderr,
-            "error: file size should be a multiple of %zd; file '%s' corrupt\n",
-            alignment, filename);
+    ReportError(error,
+                "file size should be a multiple of %zd; file '%s' corrupt",
+                alignment, filename);
     return false;
   }
   return true;
@@ -126,12 +159,13 @@ bool MatchIgnoreCase(const char* token, const char* expect, size_t len) {
   return true;
 }
 
-// Helper class to tokenize a hex stream
+// Helper class to tokenize a hex stream.  Parse errors are reported through
+// |error|.
 class HexTokenizer {
  public:
   HexTokenizer(const char* filename, const std::vector<char>& stream,
-               std::vector<uint32_t>* data)
-      : filename_(filename), stream_(stream), data_(data) {
+               std::vector<uint32_t>* data, std::string* error = nullptr)
+      : filename_(filename), stream_(stream), data_(data), error_(error) {
     DetermineMode();
   }
 
@@ -150,9 +184,9 @@ class HexTokenizer {
  private:
   void ParseError(const char* reason) {
     if (!encountered_error_) {
-      fprintf(stderr,
-              "error: hex stream parse error at character %zu: %s in '%s'\n",
-              current_, reason, filename_);
+      ReportError(error_,
+                  "hex stream parse error at character %zu: %s in '%s'",
+                  current_, reason, filename_);
       encountered_error_ = true;
     }
   }
@@ -238,10 +272,10 @@ class HexTokenizer {
     }
 
     if (encountered_error_) {
-      fprintf(stderr,
-              "error: hex format detected, but pattern '%.11s' is not "
-              "recognized '%s'\n",
-              first_token, filename_);
+      ReportError(error_,
+                  "hex format detected, but pattern '%.11s' is not "
+                  "recognized '%s'",
+                  first_token, filename_);
     }
 
     // Reset the position to restart parsing with the determined mode.
@@ -345,6 +379,7 @@ class HexTokenizer {
   const char* filename_;
   const std::vector<char>& stream_;
   std::vector<uint32_t>* data_;
+  std::string* error_;
 
   HexMode mode_ = HexMode::Words;
   size_t current_ = 0;
@@ -352,7 +387,8 @@ class HexTokenizer {
 };
 }  // namespace
 
-bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
+bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data,
+                    std::string* error) {
   assert(data->empty());
 
   const bool use_file = filename && strcmp("-", filename);
@@ -368,7 +404,7 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
   // processed as such.
   std::vector<char> data_raw;
   ReadFile(fp, &data_raw);
-  bool succeeded = WasFileCorrectlyRead(fp, filename);
+  bool succeeded = WasFileCorrectlyRead(fp, filename, error);
   if (use_file && fp) fclose(fp);
 
   if (!succeeded) {
@@ -377,11 +413,12 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
 
   if (IsHexStream(data_raw)) {
     // If a hex stream, parse it and fill |data|.
-    HexTokenizer tokenizer(filename, data_raw, data);
+    HexTokenizer tokenizer(filename, data_raw, data, error);
     succeeded = tokenizer.Parse();
   } else {
     // If not a hex stream, convert it to uint32_t via memcpy.
-    succeeded = WasFileSizeAligned(filename, data_raw.size(), sizeof(uint32_t));
+    succeeded = WasFileSizeAligned(filename, data_raw.size(),
+                                   sizeof(uint32_t), error);
     if (succeeded) {
       data->resize(data_raw.size() / sizeof(uint32_t), 0);
       memcpy(data->data(), data_raw.data(), data_raw.size());
@@ -391,6 +428,101 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
   return succeeded;
 }
 
+namespace {
+#if defined(SPIRV_MAP_INPUT_FILES)
+// The first word of a SPIR-V binary.
+constexpr uint32_t kMagicNumber = 0x07230203;
+
+// Maps the whole file |filename| into memory for reading.  Returns the address
+// of the mapping and sets |size| to its size in bytes, or returns nullptr if
+// |filename| is not a non-empty regular file or cannot be mapped.
+const void* MapFile(const char* filename, size_t* size) {
+  const void* address = nullptr;
+#if defined(SPIRV_WINDOWS)
+  HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return nullptr;
+  LARGE_INTEGER file_size;
+  if (GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &file_size) &&
+      file_size.QuadPart > 0 &&
+      static_cast<unsigned long long>(file_size.QuadPart) <= SIZE_MAX) {
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr) {
+      address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      // The view keeps the mapping alive.
+      CloseHandle(mapping);
+      if (address != nullptr) *size = static_cast<size_t>(file_size.QuadPart);
+    }
+  }
+  CloseHandle(file);
+#else
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) return nullptr;
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+      file_stat.st_size > 0) {
+    void* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size),
+                         PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      address = mapping;
+      *size = static_cast<size_t>(file_stat.st_size);
+    }
+  }
+  // The mapping stays valid after the file is closed.
+  close(fd);
+#endif
+  return address;
+}
+
+// Unmaps the |size| bytes at |address| that were mapped by |MapFile|.
+void UnmapFile(const void* address, size_t size) {
+#if defined(SPIRV_WINDOWS)
+  (void)size;
+  UnmapViewOfFile(address);
+#else
+  munmap(const_cast<void*>(address), size);
+#endif
+}
+#endif  // defined(SPIRV_MAP_INPUT_FILES)
+}  // namespace
+
+void BinaryInput::Release() {
+#if defined(SPIRV_MAP_INPUT_FILES)
+  if (mapped_ != nullptr) {
+    UnmapFile(mapped_, mapped_words_ * sizeof(uint32_t));
+  }
+#endif
+  mapped_ = nullptr;
+  mapped_words_ = 0;
+  std::vector<uint32_t>().swap(buffer_);
+}
+
+bool ReadBinaryInput(const char* filename, BinaryInput* input,
+                     std::string* error) {
+  input->Release();
+
+#if defined(SPIRV_MAP_INPUT_FILES)
+  const bool use_file = filename && strcmp("-", filename);
+  size_t size = 0;
+  const void* address = use_file ? MapFile(filename, &size) : nullptr;
+  if (address != nullptr) {
+    // Only binaries made of whole words that start with the magic number in
+    // the byte order of the host can be read in place.
+    uint32_t magic = 0;
+    if (size >= sizeof(magic)) memcpy(&magic, address, sizeof(magic));
+    if (size % sizeof(uint32_t) == 0 && magic == kMagicNumber) {
+      input->mapped_ = static_cast<const uint32_t*>(address);
+      input->mapped_words_ = size / sizeof(uint32_t);
+      return true;
+    }
+    UnmapFile(address, size);
+  }
+#endif
+
+  return ReadBinaryFile(filename, &input->buffer_, error);
+}
+
 bool ConvertHexToBinary(const std::vector<char>& stream,
                         std::vector<uint32_t>* data) {
   HexTokenizer tokenizer("<input string>", stream, data);
@@ -410,7 +542,7 @@ bool ReadTextFile(const char* filename, std::vector<char>* data) {
   }
 
   ReadFile(fp, data);
-  bool succeeded = WasFileCorrectlyRead(fp, filename);
+  bool succeeded = WasFileCorrectlyRead(fp, filename, nullptr);
   if (use_file && fp) fclose(fp);
   return succeeded;
 }
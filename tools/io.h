@@ -18,13 +18,15 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <string>
 #include <vector>
 
 // Sets the contents of the file named |filename| in |data|, assuming each
 // element in the file is of type |uint32_t|. The file is opened as a binary
 // file. If |filename| is nullptr or "-", reads from the standard input, but
-// reopened as a binary file. If any error occurs, writes error messages to
-// standard error and returns false.
+// reopened as a binary file. If any error occurs, returns false and writes
+// error messages to standard error, or appends them to |error| if it is not
+// null.
 //
 // If the given input is detected to be in ascii hex, it is converted to binary
 // automatically.  In that case, the shape of the input data is determined based
@@ -39,7 +41,51 @@
 //    big-endian order
 //  * "03[, ]02...": Every following "XY" represents a byte, stored in
 //    little-endian order
-bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data);
+bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data,
+                    std::string* error = nullptr);
+
+// The words of a SPIR-V binary read by |ReadBinaryInput|.  The words are
+// either read in place from a memory mapping of the input file, or held in a
+// buffer.
+class BinaryInput {
+ public:
+  BinaryInput() = default;
+  ~BinaryInput() { Release(); }
+
+  BinaryInput(const BinaryInput&) = delete;
+  BinaryInput& operator=(const BinaryInput&) = delete;
+
+  // Returns the words of the binary.
+  const uint32_t* data() const {
+    return mapped_ != nullptr ? mapped_ : buffer_.data();
+  }
+
+  // Returns the number of words of the binary.
+  size_t size() const {
+    return mapped_ != nullptr ? mapped_words_ : buffer_.size();
+  }
+
+  // Unmaps or frees the words.  The binary is empty afterwards.  This must be
+  // called before the input file is overwritten.
+  void Release();
+
+ private:
+  friend bool ReadBinaryInput(const char* filename, BinaryInput* input,
+                              std::string* error);
+
+  std::vector<uint32_t> buffer_;
+  const uint32_t* mapped_ = nullptr;
+  size_t mapped_words_ = 0;
+};
+
+// Reads the SPIR-V binary named |filename| into |input|.  A regular file that
+// holds a binary in the byte order of the host is mapped into memory instead
+// of being copied, so that the tools do not hold a second copy of a large
+// input.  Other inputs, such as standard input, hex text and byte-swapped
+// binaries, are read by |ReadBinaryFile|.  If any error occurs, returns false
+// and reports the errors as |ReadBinaryFile| does.
+bool ReadBinaryInput(const char* filename, BinaryInput* input,
+                     std::string* error = nullptr);
 
 // The hex->binary logic of |ReadBinaryFile| applied to a pre-loaded stream of
 // bytes.  Used by tests to avoid having to call |ReadBinaryFile| with temp
@@ -180,9 +180,13 @@ int main(int, const char* argv[]) {
 
   options.SetHasFnVarCapabilities(flags::fnvar_capabilities.value());
 
-  std::vector<std::vector<uint32_t>> contents(inFiles.size());
+  std::vector<BinaryInput> contents(inFiles.size());
+  std::vector<const uint32_t*> binaries(inFiles.size());
+  std::vector<size_t> binary_sizes(inFiles.size());
   for (size_t i = 0u; i < inFiles.size(); ++i) {
-    if (!ReadBinaryFile(inFiles[i].c_str(), &contents[i])) return 1;
+    if (!ReadBinaryInput(inFiles[i].c_str(), &contents[i])) return 1;
+    binaries[i] = contents[i].data();
+    binary_sizes[i] = contents[i].size();
   }
 
   const spvtools::MessageConsumer consumer = [](spv_message_level_t level,
@@ -211,9 +215,14 @@ int main(int, const char* argv[]) {
   context.SetMessageConsumer(consumer);
 
   std::vector<uint32_t> linkingResult;
-  spv_result_t status = Link(context, contents, &linkingResult, options);
+  spv_result_t status = Link(context, binaries.data(), binary_sizes.data(),
+                             binaries.size(), &linkingResult, options);
   if (status != SPV_SUCCESS && status != SPV_WARNING) return 1;
 
+  // The inputs may be mapped from the output file, so they must be released
+  // before the output is written.
+  contents.clear();
+
   if (!WriteFile<uint32_t>(outFile.c_str(), "wb", linkingResult.data(),
                            linkingResult.size()))
     return 1;
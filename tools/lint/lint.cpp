@@ -12,34 +12,113 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "source/opt/log.h"
 #include "spirv-tools/linter.hpp"
 #include "tools/io.h"
 #include "tools/util/cli_consumer.h"
 #include "tools/util/flags.h"
+#include "tools/util/parallel.h"
 
 namespace {
 
 constexpr auto kDefaultEnvironment = SPV_ENV_UNIVERSAL_1_6;
 constexpr auto kHelpTextFmt =
-    R"(%s - Lint a SPIR-V binary module.
+    R"(%s - Lint SPIR-V binary modules.
 
-Usage: %s [options] <filename>
+Usage: %s [options] <filename> [<filename> ...]
+
+When more than one module is given, the modules are linted in parallel, and
+the messages of each module are printed together, prefixed with its file name.
 
 Options:
 
   -h, --help      Print this help.
   --version       Display assembler version information.
+  --jobs <n>      Lint at most <n> modules at the same time. The default, 0,
+                  uses one thread per hardware thread.
+  --timing        Print the time spent in each lint, summed over all modules,
+                  to standard error.
 )";
 
+// A message emitted while linting a module.
+struct Message {
+  spv_message_level_t level;
+  spv_position_t position;
+  std::string text;
+};
+
+// The outcome of linting one module.
+struct ModuleResult {
+  bool passed = false;
+  std::vector<Message> messages;
+  std::vector<spvtools::LintReport> reports;
+};
+
+// Lints the module in |filename| and stores the outcome in |result|. The
+// messages are buffered so that the output of modules linted in parallel is
+// not interleaved.
+void LintModule(const std::string& filename, bool timing,
+                ModuleResult* result) {
+  std::vector<uint32_t> binary;
+  if (!ReadBinaryFile(filename.c_str(), &binary)) return;
+
+  spvtools::Linter linter(kDefaultEnvironment);
+  linter.SetMessageConsumer(
+      [result](spv_message_level_t level, const char*,
+               const spv_position_t& position, const char* message) {
+        result->messages.push_back({level, position, message});
+      });
+  if (timing) {
+    linter.SetLintReportCallback(
+        [result](const spvtools::LintReport& report) {
+          result->reports.push_back(report);
+        });
+  }
+  result->passed = linter.Run(binary.data(), binary.size());
+}
+
+// Prints the total and average time of each lint over |results|.
+void PrintTiming(const std::vector<ModuleResult>& results, double wall_time) {
+  struct Total {
+    double wall_time = 0;
+    size_t runs = 0;
+    size_t failures = 0;
+  };
+  std::map<std::string, Total> totals;
+  for (const ModuleResult& result : results) {
+    for (const spvtools::LintReport& report : result.reports) {
+      Total& total = totals[report.name];
+      total.wall_time += report.wall_time;
+      ++total.runs;
+      if (!report.passed) ++total.failures;
+    }
+  }
+
+  fprintf(stderr, "Linted %zu modules in %.6f s\n", results.size(),
+          wall_time);
+  for (const auto& entry : totals) {
+    const Total& total = entry.second;
+    fprintf(stderr, "  %-24s %10.6f s total %10.6f s per module %zu failed\n",
+            entry.first.c_str(), total.wall_time,
+            total.wall_time / static_cast<double>(total.runs),
+            total.failures);
+  }
+}
+
 }  // namespace
 
 // clang-format off
 FLAG_SHORT_bool(  h,       /* default_value= */ false, /* required= */ false);
 FLAG_LONG_bool(   help,    /* default_value= */ false, /* required= */ false);
 FLAG_LONG_bool(   version, /* default_value= */ false, /* required= */ false);
+FLAG_LONG_uint(   jobs,    /* default_value= */ 0,     /* required= */ false);
+FLAG_LONG_bool(   timing,  /* default_value= */ false, /* required= */ false);
 // clang-format on
 
 int main(int, const char** argv) {
@@ -57,18 +136,40 @@ int main(int, const char** argv) {
     return 0;
   }
 
-  if (flags::positional_arguments.size() != 1) {
+  const std::vector<std::string>& files = flags::positional_arguments;
+  if (files.empty()) {
     spvtools::Error(spvtools::utils::CLIMessageConsumer, nullptr, {},
-                    "expected exactly one input file.");
+                    "expected at least one input file.");
     return 1;
   }
 
-  spvtools::Linter linter(kDefaultEnvironment);
-  linter.SetMessageConsumer(spvtools::utils::CLIMessageConsumer);
-  std::vector<uint32_t> binary;
-  if (!ReadBinaryFile(flags::positional_arguments[0].c_str(), &binary)) {
-    return 1;
+  const bool timing = flags::timing.value();
+  std::vector<ModuleResult> results(files.size());
+  const auto start = std::chrono::steady_clock::now();
+  spvtools::utils::ParallelFor(
+      files.size(), spvtools::utils::GetWorkerCount(flags::jobs.value()),
+      [&files, &results, timing](size_t i) {
+        LintModule(files[i], timing, &results[i]);
+      });
+  const double wall_time = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+
+  // Print the messages in the order of the input files, so that the output
+  // does not depend on the scheduling of the threads.
+  const bool batch = files.size() > 1;
+  bool passed = true;
+  for (size_t i = 0; i < files.size(); ++i) {
+    for (const Message& message : results[i].messages) {
+      const std::string text =
+          batch ? files[i] + ": " + message.text : message.text;
+      spvtools::utils::CLIMessageConsumer(message.level, "", message.position,
+                                          text.c_str());
+    }
+    passed &= results[i].passed;
   }
 
-  return linter.Run(binary.data(), binary.size()) ? 0 : 1;
+  if (timing) PrintTiming(results, wall_time);
+
+  return passed ? 0 : 1;
 }
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -24,10 +25,12 @@
 
 #include "source/opt/log.h"
 #include "source/spirv_target_env.h"
+#include "source/util/parse_number.h"
 #include "source/util/string_utils.h"
 #include "spirv-tools/libspirv.hpp"
 #include "spirv-tools/optimizer.hpp"
 #include "tools/io.h"
+#include "tools/util/batch.h"
 #include "tools/util/cli_consumer.h"
 
 namespace {
@@ -40,6 +43,19 @@ struct OptStatus {
   int code;
 };
 
+// Options of the --batch mode.
+struct BatchOptions {
+  // The manifest or directory naming the inputs, or empty if the tool
+  // optimizes a single input.
+  std::string path;
+  // The number of worker threads, or 0 for one per hardware thread.
+  unsigned jobs = 0;
+  // A flag that prints pass output to standard error, or empty if there is
+  // none.  Such flags cannot be used with --batch, since the files are
+  // optimized concurrently.
+  std::string stderr_flag;
+};
+
 // Message consumer for this tool.  Used to emit diagnostics during
 // initialization and setup. Note that |source| and |position| are irrelevant
 // here because we are still not processing a SPIR-V input file.
@@ -61,6 +77,46 @@ std::string GetListOfPassesAsString(const spvtools::Optimizer& optimizer) {
 
 const auto kDefaultEnvironment = SPV_ENV_UNIVERSAL_1_6;
 
+// Writes |str| to |out| as a JSON string literal.
+void WriteJsonString(std::ostream& out, const std::string& str) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  out << '"';
+  for (const char c : str) {
+    const unsigned char byte = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (byte < 0x20) {
+      out << "\\u00" << kHexDigits[byte >> 4] << kHexDigits[byte & 0xf];
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+// Prints |report| to standard error as a JSON object on a line of its own,
+// for --time-report=json.
+void PrintPassReportAsJson(const spvtools::PassReport& report) {
+  std::ostringstream out;
+  out << "{\"pass\": ";
+  WriteJsonString(out, report.name);
+  out << ", \"changed\": " << (report.changed ? "true" : "false")
+      << ", \"wall_time\": " << report.wall_time
+      << ", \"cpu_time\": " << report.cpu_time
+      << ", \"rss_delta_kb\": " << report.rss_delta
+      << ", \"instructions_before\": " << report.instructions_before
+      << ", \"instructions_after\": " << report.instructions_after
+      << ", \"words_before\": " << report.words_before
+      << ", \"words_after\": " << report.words_after
+      << ", \"invalidated_analyses\": [";
+  for (size_t i = 0; i < report.invalidated_analyses.size(); ++i) {
+    if (i > 0) out << ", ";
+    WriteJsonString(out, report.invalidated_analyses[i]);
+  }
+  out << "]}\n";
+  std::cerr << out.str();
+}
+
 std::string GetLegalizationPasses() {
   spvtools::Optimizer optimizer(kDefaultEnvironment);
   optimizer.RegisterLegalizationPasses();
@@ -86,22 +142,36 @@ void PrintUsage(const char* program) {
       R"(%s - Optimize a SPIR-V binary file.
 
 USAGE: %s [options] [<input>] -o <output>
+       %s [options] --batch=<manifest or directory>
 
 The SPIR-V binary is read from <input>. If no file is specified,
 or if <input> is "-", then the binary is read from standard input.
 if <output> is "-", then the optimized output is written to
 standard output.
 
+With --batch, the files listed by a manifest or found in a directory are
+optimized in parallel. The output of each <name>.spv is written alongside
+it, to <name>.opt.spv.
+
 NOTE: The optimizer is a work in progress.
 
 Options (in lexicographical order):)",
-      program, program);
+      program, program, program);
   printf(R"(
   --amd-ext-to-khr
                Replaces the extensions VK_AMD_shader_ballot, VK_AMD_gcn_shader,
                and VK_AMD_shader_trinary_minmax with equivalent code using core
                instructions and capabilities.)");
   printf(R"(
+  --batch=<manifest or directory>
+               Optimizes every file listed in the manifest, one path per
+               line, or every .spv file in the directory, except the .opt.spv
+               outputs of an earlier batch. Prints a status line for each
+               file followed by the throughput of the whole batch. Cannot be
+               used with an input file, with -o, or with the options that
+               print pass output: --pass-statistics, --print-all,
+               --print-changed and --time-report.)");
+  printf(R"(
   --before-hlsl-legalization
                Forwards this option to the validator.  See the validator help
                for details.)");
@@ -194,9 +264,11 @@ Options (in lexicographical order):)",
                indicated unconditional branch. Delete all resulting dead
                code. Performed only on entry point call tree functions.)");
   printf(R"(
-  --eliminate-dead-code-aggressive
+  --eliminate-dead-code-aggressive[=incremental]
                Delete instructions which do not contribute to a function's
-               output. Performed only on entry point call tree functions.)");
+               output. Performed only on entry point call tree functions.
+               With 'incremental', functions that have not changed since the
+               previous incremental run are not processed again.)");
   printf(R"(
   --eliminate-dead-const
                Eliminate dead constants.)");
@@ -269,6 +341,15 @@ Options (in lexicographical order):)",
                functions. Currently does not inline calls to functions with
                early return in a loop.)");
   printf(R"(
+  --inline-entry-points-budget=<n>
+               Like --inline-entry-points-exhaustive, but functions with more
+               than <n> instructions are only inlined if they have a single
+               call site.)");
+  printf(R"(
+  --jobs=<n>
+               With --batch, optimizes at most <n> files at the same time.
+               The default, 0, uses one thread per hardware thread.)");
+  printf(R"(
   --legalize-hlsl
                Runs a series of optimizations that attempts to take SPIR-V
                generated by an HLSL front-end and generates legal Vulkan SPIR-V.
@@ -312,6 +393,13 @@ Options (in lexicographical order):)",
                additional non-0 integer argument to set the unroll factor, or
                how many times a loop body should be duplicated)");
   printf(R"(
+  --loop-unroll-auto[=<n>]
+               Unrolls loops that are not marked with the DontUnroll flag,
+               fully or partially, picking the factor of each loop from its
+               size, trip count and register pressure. The unrolling adds at
+               most <n> instructions to the module; the default is 2000. Each
+               decision is printed as an info message.)");
+  printf(R"(
   --loop-peeling
                Execute few first (respectively last) iterations before
                (respectively after) the loop if it can elide some branches.)");
@@ -362,7 +450,9 @@ Options (in lexicographical order):)",
                Optimize for performance. Apply a sequence of transformations
                in an attempt to improve the performance of the generated
                code. For this version of the optimizer, this flag is equivalent
-               to specifying the following optimization code names:
+               to specifying the following optimization code names, except
+               that some clean-up sequences are repeated until they make no
+               further change:
                %s)",
          GetOptimizationPasses().c_str());
   printf(R"(
@@ -406,6 +496,11 @@ Options (in lexicographical order):)",
                --merge-blocks followed by all the transformations implied by
                -O.)");
   printf(R"(
+  --pass-statistics
+               Print, for each pass, how many times it ran, how many of those
+               runs changed the module, and how many times it was skipped
+               because it could not make a change, to standard error output.)");
+  printf(R"(
   --preserve-bindings
                Ensure that the optimizer preserves all bindings declared within
                the module, even when those bindings are unused.)");
@@ -423,6 +518,12 @@ Options (in lexicographical order):)",
                Print SPIR-V assembly to standard error output before each pass
                and after the last pass.)");
   printf(R"(
+  --print-changed
+               Print SPIR-V assembly to standard error output before the first
+               pass and then, after each pass that changed the module, only the
+               global declarations and functions whose assembly changed. This
+               is much faster than --print-all on large modules.)");
+  printf(R"(
   --private-to-local
                Change the scope of private variables that are used in a single
                function to that function.)");
@@ -434,6 +535,12 @@ Options (in lexicographical order):)",
                we replace the load.  <threshold> is a double type number.  If
                it is bigger than 1.0, we always replaces the load.)");
   printf(R"(
+  --reduce-register-pressure
+               Reorders the instructions of each basic block to lower the
+               number of values that are live at the same time. The maximum
+               register pressure of each function before and after the pass
+               is printed as an info message.)");
+  printf(R"(
   --redundancy-elimination
                Looks for instructions in the same function that compute the
                same value, and deletes the redundant ones.)");
@@ -520,6 +627,13 @@ Options (in lexicographical order):)",
                is invalid, the optimizer may fail or generate incorrect code.
                This options should be used rarely, and with caution.)");
   printf(R"(
+  --skip-unchanged-functions
+               When a pass that supports incremental processing runs more
+               than once, only revisit functions that have been modified since
+               its previous run.  This can reduce compile time for long
+               pass sequences, at the cost of possibly missing optimization
+               opportunities exposed by changes elsewhere in the module.)");
+  printf(R"(
   --split-combined-image-sampler
                Replace combined image sampler variables and parameters into
                pairs of images and samplers.  New variables have the same
@@ -561,6 +675,14 @@ Options (in lexicographical order):)",
                USR/SYS time are returned by getrusage() and can have a small
                error.)");
   printf(R"(
+  --time-report=json
+               Print a JSON object per pass run to standard error output, one
+               per line. Each object has the pass name, whether it changed the
+               module, its wall and CPU time in seconds, the growth of the peak
+               RSS in kilobytes (-1 if unavailable), the number of instructions
+               and words in the module before and after the pass, and the
+               analyses the pass invalidated.)");
+  printf(R"(
   --trim-capabilities
                Remove unnecessary capabilities and extensions declared within the
                module.)");
@@ -597,6 +719,12 @@ Options (in lexicographical order):)",
   --validate-after-all
                Validate the module after each pass is performed.)");
   printf(R"(
+  --validate-after-changes
+               Like --validate-after-all, but once the module has been
+               validated, skips the validation after the passes that report
+               that they did not change the module. This is much faster, but
+               trusts the passes to report their changes correctly.)");
+  printf(R"(
   -h, --help
                Print this help.)");
   printf(R"(
@@ -655,20 +783,22 @@ OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
                      const char** out_file,
                      spvtools::ValidatorOptions* validator_options,
-                     spvtools::OptimizerOptions* optimizer_options);
+                     spvtools::OptimizerOptions* optimizer_options,
+                     BatchOptions* batch_options);
 
 // Parses and handles the -Oconfig flag. |prog_name| contains the name of
 // the spirv-opt binary (used to build a new argv vector for the recursive
 // invocation to ParseFlags). |opt_flag| contains the -Oconfig=FILENAME flag.
-// |optimizer|, |in_file|, |out_file|, |validator_options|, and
-// |optimizer_options| are as in ParseFlags.
+// |optimizer|, |in_file|, |out_file|, |validator_options|,
+// |optimizer_options| and |batch_options| are as in ParseFlags.
 //
 // This returns the same OptStatus instance returned by ParseFlags.
 OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
                            spvtools::Optimizer* optimizer, const char** in_file,
                            const char** out_file,
                            spvtools::ValidatorOptions* validator_options,
-                           spvtools::OptimizerOptions* optimizer_options) {
+                           spvtools::OptimizerOptions* optimizer_options,
+                           BatchOptions* batch_options) {
   std::vector<std::string> flags;
   flags.push_back(prog_name);
 
@@ -693,7 +823,7 @@ OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
 
   auto ret_val =
       ParseFlags(static_cast<int>(flags.size()), new_argv, optimizer, in_file,
-                 out_file, validator_options, optimizer_options);
+                 out_file, validator_options, optimizer_options, batch_options);
   delete[] new_argv;
   return ret_val;
 }
@@ -750,7 +880,8 @@ OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
                      const char** out_file,
                      spvtools::ValidatorOptions* validator_options,
-                     spvtools::OptimizerOptions* optimizer_options) {
+                     spvtools::OptimizerOptions* optimizer_options,
+                     BatchOptions* batch_options) {
   std::vector<std::string> pass_flags;
   bool preserve_interface = false;
   for (int argi = 1; argi < argc; ++argi) {
@@ -782,20 +913,45 @@ OptStatus ParseFlags(int argc, const char** argv,
       } else if (0 == strncmp(cur_arg, "-Oconfig=", sizeof("-Oconfig=") - 1)) {
         OptStatus status =
             ParseOconfigFlag(argv[0], cur_arg, optimizer, in_file, out_file,
-                             validator_options, optimizer_options);
+                             validator_options, optimizer_options,
+                             batch_options);
         if (status.action != OPT_CONTINUE) {
           return status;
         }
+      } else if (0 == strncmp(cur_arg, "--batch=", sizeof("--batch=") - 1)) {
+        batch_options->path = cur_arg + sizeof("--batch=") - 1;
+      } else if (0 == strncmp(cur_arg, "--jobs=", sizeof("--jobs=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        uint32_t jobs = 0;
+        if (!spvtools::utils::ParseNumber(split_flag.second.c_str(), &jobs)) {
+          spvtools::Error(opt_diagnostic, nullptr, {},
+                          "Invalid value passed to --jobs");
+          return {OPT_STOP, 1};
+        }
+        batch_options->jobs = jobs;
       } else if (0 == strcmp(cur_arg, "--skip-validation")) {
         optimizer_options->set_run_validator(false);
       } else if (0 == strcmp(cur_arg, "--print-all")) {
         optimizer->SetPrintAll(&std::cerr);
+        batch_options->stderr_flag = cur_arg;
+      } else if (0 == strcmp(cur_arg, "--print-changed")) {
+        optimizer->SetPrintChanged(&std::cerr);
+        batch_options->stderr_flag = cur_arg;
+      } else if (0 == strcmp(cur_arg, "--pass-statistics")) {
+        optimizer->SetPassStatistics(&std::cerr);
+        batch_options->stderr_flag = cur_arg;
       } else if (0 == strcmp(cur_arg, "--preserve-bindings")) {
         optimizer_options->set_preserve_bindings(true);
       } else if (0 == strcmp(cur_arg, "--preserve-spec-constants")) {
         optimizer_options->set_preserve_spec_constants(true);
+      } else if (0 == strcmp(cur_arg, "--skip-unchanged-functions")) {
+        optimizer_options->set_skip_unchanged_functions(true);
       } else if (0 == strcmp(cur_arg, "--time-report")) {
         optimizer->SetTimeReport(&std::cerr);
+        batch_options->stderr_flag = cur_arg;
+      } else if (0 == strcmp(cur_arg, "--time-report=json")) {
+        optimizer->SetPassReportCallback(PrintPassReportAsJson);
+        batch_options->stderr_flag = cur_arg;
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         validator_options->SetRelaxStructStore(true);
       } else if (0 == strncmp(cur_arg, "--max-id-bound=",
@@ -828,6 +984,9 @@ OptStatus ParseFlags(int argc, const char** argv,
         optimizer->SetTargetEnv(target_env);
       } else if (0 == strcmp(cur_arg, "--validate-after-all")) {
         optimizer->SetValidateAfterAll(true);
+      } else if (0 == strcmp(cur_arg, "--validate-after-changes")) {
+        optimizer->SetValidateAfterAll(true);
+        optimizer->SetSkipValidationOfUnchangedModule(true);
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
         validator_options->SetBeforeHlslLegalization(true);
       } else if (0 == strcmp(cur_arg, "--relax-logical-pointer")) {
@@ -873,6 +1032,89 @@ OptStatus ParseFlags(int argc, const char** argv,
   return {OPT_CONTINUE, 0};
 }
 
+// Returns the path the output of the batch input |input| is written to:
+// <name>.opt.spv for <name>.spv, and <input>.opt.spv for other names.
+std::string GetBatchOutputPath(const std::string& input) {
+  std::filesystem::path path(input);
+  if (path.extension() == ".spv") path.replace_extension();
+  path += ".opt.spv";
+  const auto u8str = path.u8string();
+  return std::string(u8str.begin(), u8str.end());
+}
+
+// Returns true if |path| is the output of an earlier batch.
+bool IsBatchOutput(const std::string& path) {
+  const std::string suffix = ".opt.spv";
+  return path.size() >= suffix.size() &&
+         path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Optimizes |filename| as part of a batch and stores the outcome in |result|.
+// Passes can only run once, so every file gets an optimizer of its own,
+// configured by parsing the command line |argc| and |argv| again.
+void OptimizeBatchFile(int argc, const char** argv, const std::string& filename,
+                       spvtools::utils::BatchResult* result) {
+  BinaryInput input;
+  std::string error;
+  if (!ReadBinaryInput(filename.c_str(), &input, &error)) {
+    result->messages.push_back({SPV_MSG_ERROR, error});
+    return;
+  }
+  result->input_bytes = input.size() * sizeof(uint32_t);
+
+  spvtools::Optimizer optimizer(kDefaultEnvironment);
+  optimizer.SetMessageConsumer(
+      spvtools::utils::BatchMessageConsumer(filename, result));
+
+  // The command line was checked before the batch started, so this only
+  // configures |optimizer| and the options.
+  const char* in_file = nullptr;
+  const char* out_file = nullptr;
+  spvtools::ValidatorOptions validator_options;
+  spvtools::OptimizerOptions optimizer_options;
+  BatchOptions batch_options;
+  ParseFlags(argc, argv, &optimizer, &in_file, &out_file, &validator_options,
+             &optimizer_options, &batch_options);
+  optimizer_options.set_validator_options(validator_options);
+
+  std::vector<uint32_t> binary;
+  bool ok =
+      optimizer.Run(input.data(), input.size(), &binary, optimizer_options);
+  if (!ok) binary.assign(input.data(), input.data() + input.size());
+  input.Release();
+
+  const std::string output = GetBatchOutputPath(filename);
+  ok &= WriteFile<uint32_t>(output.c_str(), "wb", binary.data(), binary.size());
+  result->ok = ok;
+}
+
+// Optimizes the files of the batch described by |batch_options| and prints a
+// summary. Returns the exit code of the tool.
+int ProcessBatch(int argc, const char** argv,
+                 const BatchOptions& batch_options) {
+  std::vector<std::string> files;
+  if (!spvtools::utils::ReadBatchInputs(batch_options.path, &files)) {
+    return 1;
+  }
+  if (std::filesystem::is_directory(batch_options.path)) {
+    files.erase(std::remove_if(files.begin(), files.end(), IsBatchOutput),
+                files.end());
+  }
+
+  double wall_time = 0;
+  const std::vector<spvtools::utils::BatchResult> results =
+      spvtools::utils::RunBatch(
+          files, batch_options.jobs,
+          [argc, argv](const std::string& file,
+                       spvtools::utils::BatchResult* result) {
+            OptimizeBatchFile(argc, argv, file, result);
+          },
+          &wall_time);
+
+  spvtools::utils::PrintBatchSummary(files, results, wall_time);
+  return spvtools::utils::BatchSucceeded(results) ? 0 : 1;
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
@@ -886,28 +1128,49 @@ int main(int argc, const char** argv) {
 
   spvtools::ValidatorOptions validator_options;
   spvtools::OptimizerOptions optimizer_options;
-  OptStatus status = ParseFlags(argc, argv, &optimizer, &in_file, &out_file,
-                                &validator_options, &optimizer_options);
+  BatchOptions batch_options;
+  OptStatus status =
+      ParseFlags(argc, argv, &optimizer, &in_file, &out_file,
+                 &validator_options, &optimizer_options, &batch_options);
   optimizer_options.set_validator_options(validator_options);
 
   if (status.action == OPT_STOP) {
     return status.code;
   }
 
+  if (!batch_options.path.empty()) {
+    if (in_file != nullptr || out_file != nullptr) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      "--batch cannot be used with an input file or -o");
+      return 1;
+    }
+    if (!batch_options.stderr_flag.empty()) {
+      spvtools::Error(
+          opt_diagnostic, nullptr, {},
+          (batch_options.stderr_flag + " cannot be used with --batch").c_str());
+      return 1;
+    }
+    return ProcessBatch(argc, argv, batch_options);
+  }
+
   if (out_file == nullptr) {
     spvtools::Error(opt_diagnostic, nullptr, {}, "-o required");
     return 1;
   }
 
-  std::vector<uint32_t> binary;
-  if (!ReadBinaryFile(in_file, &binary)) {
+  BinaryInput input;
+  if (!ReadBinaryInput(in_file, &input)) {
     return 1;
   }
 
-  // By using the same vector as input and output, we save time in the case
-  // that there was no change.
+  std::vector<uint32_t> binary;
   bool ok =
-      optimizer.Run(binary.data(), binary.size(), &binary, optimizer_options);
+      optimizer.Run(input.data(), input.size(), &binary, optimizer_options);
+  // A failed run writes the input back unchanged.
+  if (!ok) binary.assign(input.data(), input.data() + input.size());
+  // The input may be mapped from the output file, so it must be released
+  // before the output is written.
+  input.Release();
 
   if (!WriteFile<uint32_t>(out_file, "wb", binary.data(), binary.size())) {
     return 1;
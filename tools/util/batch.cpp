@@ -0,0 +1,158 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tools/util/batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "tools/util/parallel.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+// Returns the elapsed time since |start|, in seconds.
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+// Returns the UTF-8 string of |path|. The string is copied because in C++20
+// std::filesystem::path::u8string returns a std::u8string.
+std::string PathToString(const std::filesystem::path& path) {
+  const auto u8str = path.u8string();
+  return std::string(u8str.begin(), u8str.end());
+}
+
+}  // namespace
+
+bool ReadBatchInputs(const std::string& batch_path,
+                     std::vector<std::string>* files) {
+  std::error_code ec;
+  if (std::filesystem::is_directory(batch_path, ec)) {
+    using DirectoryIterator = std::filesystem::recursive_directory_iterator;
+    for (DirectoryIterator it(batch_path, ec);
+         !ec && it != DirectoryIterator(); it.increment(ec)) {
+      if (it->is_regular_file(ec) && it->path().extension() == ".spv") {
+        files->push_back(PathToString(it->path()));
+      }
+    }
+    if (ec) {
+      fprintf(stderr, "error: cannot list directory %s: %s\n",
+              batch_path.c_str(), ec.message().c_str());
+      return false;
+    }
+    std::sort(files->begin(), files->end());
+    return true;
+  }
+
+  std::ifstream manifest(batch_path);
+  if (!manifest) {
+    fprintf(stderr, "error: cannot open batch manifest %s\n",
+            batch_path.c_str());
+    return false;
+  }
+  std::string line;
+  while (std::getline(manifest, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty() || line[0] == '#') continue;
+    files->push_back(line);
+  }
+  return true;
+}
+
+MessageConsumer BatchMessageConsumer(const std::string& filename,
+                                     BatchResult* result) {
+  return [filename, result](spv_message_level_t level, const char*,
+                            const spv_position_t& position,
+                            const char* message) {
+    const char* prefix = nullptr;
+    switch (level) {
+      case SPV_MSG_FATAL:
+      case SPV_MSG_INTERNAL_ERROR:
+      case SPV_MSG_ERROR:
+        prefix = "error: ";
+        break;
+      case SPV_MSG_WARNING:
+        prefix = "warning: ";
+        break;
+      case SPV_MSG_INFO:
+        prefix = "info: ";
+        break;
+      default:
+        return;
+    }
+    result->messages.push_back(
+        {level, prefix + filename + ":" + std::to_string(position.index) +
+                    ": " + message});
+  };
+}
+
+std::vector<BatchResult> RunBatch(
+    const std::vector<std::string>& files, unsigned num_threads,
+    const std::function<void(const std::string& file, BatchResult* result)>&
+        process,
+    double* wall_time) {
+  std::vector<BatchResult> results(files.size());
+  const auto batch_start = std::chrono::steady_clock::now();
+  ParallelFor(files.size(), GetWorkerCount(num_threads),
+              [&files, &results, &process](size_t i) {
+                const auto start = std::chrono::steady_clock::now();
+                process(files[i], &results[i]);
+                results[i].wall_time = SecondsSince(start);
+              });
+  *wall_time = SecondsSince(batch_start);
+  return results;
+}
+
+void PrintBatchSummary(const std::vector<std::string>& files,
+                       const std::vector<BatchResult>& results,
+                       double wall_time) {
+  size_t num_failed = 0;
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    const BatchResult& result = results[i];
+    for (const BatchMessage& message : result.messages) {
+      const bool is_error = message.level == SPV_MSG_FATAL ||
+                            message.level == SPV_MSG_INTERNAL_ERROR ||
+                            message.level == SPV_MSG_ERROR;
+      fprintf(is_error ? stderr : stdout, "%s\n", message.text.c_str());
+    }
+    fprintf(stdout, "%s: %s (%.3f ms)\n", files[i].c_str(),
+            result.ok ? "ok" : "failed", result.wall_time * 1000.0);
+    if (!result.ok) ++num_failed;
+    total_bytes += result.input_bytes;
+  }
+
+  const double seconds = std::max(wall_time, 1e-9);
+  fprintf(stdout,
+          "Processed %zu files (%zu failed) in %.3f s: %.1f files/s, "
+          "%.2f MiB/s\n",
+          files.size(), num_failed, wall_time,
+          static_cast<double>(files.size()) / seconds,
+          static_cast<double>(total_bytes) / (1024.0 * 1024.0) / seconds);
+}
+
+bool BatchSucceeded(const std::vector<BatchResult>& results) {
+  return std::all_of(results.begin(), results.end(),
+                     [](const BatchResult& result) { return result.ok; });
+}
+
+}  // namespace utils
+}  // namespace spvtools
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLS_UTIL_BATCH_H_
+#define TOOLS_UTIL_BATCH_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "spirv-tools/libspirv.hpp"
+
+namespace spvtools {
+namespace utils {
+
+// A message emitted while processing one file of a batch.
+struct BatchMessage {
+  spv_message_level_t level;
+  std::string text;
+};
+
+// The outcome of processing one file of a batch.
+struct BatchResult {
+  // Whether the file was processed successfully.
+  bool ok = false;
+  // The size of the input file, in bytes.
+  size_t input_bytes = 0;
+  // The wall clock time taken to process the file, in seconds.
+  double wall_time = 0;
+  // The messages emitted while processing the file, in order.
+  std::vector<BatchMessage> messages;
+};
+
+// Sets |files| to the inputs of a batch named by |batch_path|. If
+// |batch_path| is a directory, the inputs are the regular files with the .spv
+// extension below it, in lexicographical order. Otherwise, |batch_path| is a
+// manifest that lists one input per line; empty lines and lines starting with
+// '#' are ignored. Returns false and writes an error to standard error if the
+// inputs cannot be listed.
+bool ReadBatchInputs(const std::string& batch_path,
+                     std::vector<std::string>* files);
+
+// Returns a message consumer that appends the messages it receives to
+// |result|, prefixed with |filename| and the position of the message.
+MessageConsumer BatchMessageConsumer(const std::string& filename,
+                                     BatchResult* result);
+
+// Processes |files| using up to |num_threads| threads; 0 means one thread
+// per hardware thread. |process| is called once per file, possibly
+// concurrently, and must set |ok| and |input_bytes| in the result it is
+// given. The time each call takes is measured here, and the time taken by
+// the whole batch is returned in |wall_time|.
+std::vector<BatchResult> RunBatch(
+    const std::vector<std::string>& files, unsigned num_threads,
+    const std::function<void(const std::string& file, BatchResult* result)>&
+        process,
+    double* wall_time);
+
+// Prints the messages and the status of each file in the order of |files|,
+// followed by the number of files that failed and the throughput of the
+// batch, which took |wall_time| seconds. Errors go to standard error and
+// everything else to standard output.
+void PrintBatchSummary(const std::vector<std::string>& files,
+                       const std::vector<BatchResult>& results,
+                       double wall_time);
+
+// Returns true if every file of the batch was processed successfully.
+bool BatchSucceeded(const std::vector<BatchResult>& results);
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // TOOLS_UTIL_BATCH_H_
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tools/util/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+unsigned GetWorkerCount(unsigned requested) {
+  if (requested != 0) return requested;
+  // hardware_concurrency may return 0 if the value is not computable.
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ParallelFor(size_t count, unsigned num_threads,
+                 const std::function<void(size_t)>& task) {
+  if (count == 0) return;
+
+  std::atomic<size_t> next(0);
+  auto worker = [&next, count, &task]() {
+    for (size_t i = next++; i < count; i = next++) {
+      task(i);
+    }
+  };
+
+  // The calling thread is one of the workers.
+  const size_t num_helpers =
+      std::min<size_t>(std::max(1u, num_threads), count) - 1;
+  std::vector<std::thread> helpers;
+  helpers.reserve(num_helpers);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    helpers.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& helper : helpers) {
+    helper.join();
+  }
+}
+
+}  // namespace utils
+}  // namespace spvtools
@@ -0,0 +1,39 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLS_UTIL_PARALLEL_H_
+#define TOOLS_UTIL_PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace spvtools {
+namespace utils {
+
+// Returns the number of worker threads to use when |requested| threads were
+// asked for on the command line. A request of 0 means one thread per hardware
+// thread.
+unsigned GetWorkerCount(unsigned requested);
+
+// Calls |task(i)| for every |i| in [0, |count|) using up to |num_threads|
+// threads, including the calling thread. Tasks are handed out in increasing
+// order of |i|, and the function returns once all of them have finished.
+// |task| must be safe to call concurrently with different indices.
+void ParallelFor(size_t count, unsigned num_threads,
+                 const std::function<void(size_t)>& task);
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // TOOLS_UTIL_PARALLEL_H_
@@ -23,6 +23,7 @@
 #include "source/spirv_validator_options.h"
 #include "spirv-tools/libspirv.hpp"
 #include "tools/io.h"
+#include "tools/util/batch.h"
 #include "tools/util/cli_consumer.h"
 
 void print_usage(char* argv0) {
@@ -38,10 +39,18 @@ The <path> parameter may also specify a directory; in this case,
 the tool will recursively process all regular files with the .spv
 extension within that directory.
 
+With --batch, the files listed by a manifest or found in a directory are
+validated in parallel, and a status line is printed for each of them followed
+by the throughput of the whole batch.
+
 NOTE: The validator is a work in progress.
 
 Options:
   -h, --help                       Print this help.
+  --batch                          <manifest or directory> Validate every file listed in the
+                                   manifest, one path per line, or every .spv file in the directory.
+  --jobs                           <n> Validate at most <n> files of a batch at the same time.
+                                   The default, 0, uses one thread per hardware thread.
   --max-struct-members             <maximum number of structure members allowed>
   --max-struct-depth               <maximum allowed nesting depth of structures>
   --max-local-variables            <maximum number of local variables allowed>
@@ -90,8 +99,8 @@ Options:
 bool process_single_file(const char* filename, spv_target_env& target_env,
                          spvtools::ValidatorOptions& options,
                          bool use_default_msg_consumer) {
-  std::vector<uint32_t> contents;
-  if (!ReadBinaryFile(filename, &contents)) return false;
+  BinaryInput contents;
+  if (!ReadBinaryInput(filename, &contents)) return false;
 
   spvtools::SpirvTools tools(target_env);
 
@@ -134,8 +143,52 @@ bool process_single_file(const char* filename, spv_target_env& target_env,
   return tools.Validate(contents.data(), contents.size(), options);
 }
 
+// Validates |filename| as part of a batch and stores the outcome, including
+// the errors reading the file, in |result|.
+void validate_batch_file(const std::string& filename,
+                         spv_target_env target_env,
+                         const spvtools::ValidatorOptions& options,
+                         spvtools::utils::BatchResult* result) {
+  BinaryInput contents;
+  std::string error;
+  if (!ReadBinaryInput(filename.c_str(), &contents, &error)) {
+    result->messages.push_back({SPV_MSG_ERROR, error});
+    return;
+  }
+  result->input_bytes = contents.size() * sizeof(uint32_t);
+
+  spvtools::SpirvTools tools(target_env);
+  tools.SetMessageConsumer(
+      spvtools::utils::BatchMessageConsumer(filename, result));
+  result->ok = tools.Validate(contents.data(), contents.size(), options);
+}
+
+// Validates the files of the batch named by |batch_path| on up to |jobs|
+// threads and prints a summary. Returns the exit code of the tool.
+int process_batch(const char* batch_path, unsigned jobs,
+                  spv_target_env target_env,
+                  const spvtools::ValidatorOptions& options) {
+  std::vector<std::string> files;
+  if (!spvtools::utils::ReadBatchInputs(batch_path, &files)) return 1;
+
+  double wall_time = 0;
+  const std::vector<spvtools::utils::BatchResult> results =
+      spvtools::utils::RunBatch(
+          files, jobs,
+          [target_env, &options](const std::string& file,
+                                 spvtools::utils::BatchResult* result) {
+            validate_batch_file(file, target_env, options, result);
+          },
+          &wall_time);
+
+  spvtools::utils::PrintBatchSummary(files, results, wall_time);
+  return spvtools::utils::BatchSucceeded(results) ? 0 : 1;
+}
+
 int main(int argc, char** argv) {
   const char* inFile = nullptr;
+  const char* batch_path = nullptr;
+  unsigned jobs = 0;
   spv_target_env target_env = SPV_ENV_UNIVERSAL_1_6;
   spvtools::ValidatorOptions options;
   bool continue_processing = true;
@@ -204,6 +257,26 @@ int main(int argc, char** argv) {
           continue_processing = false;
           return_code = 1;
         }
+      } else if (0 == strcmp(cur_arg, "--batch")) {
+        if (argi + 1 < argc) {
+          batch_path = argv[++argi];
+        } else {
+          fprintf(stderr, "error: Missing argument to --batch\n");
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--jobs")) {
+        if (argi + 1 < argc) {
+          if (sscanf(argv[++argi], "%u", &jobs) != 1) {
+            fprintf(stderr, "error: Invalid argument to --jobs\n");
+            continue_processing = false;
+            return_code = 1;
+          }
+        } else {
+          fprintf(stderr, "error: Missing argument to --jobs\n");
+          continue_processing = false;
+          return_code = 1;
+        }
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
         options.SetBeforeHlslLegalization(true);
       } else if (0 == strcmp(cur_arg, "--relax-logical-pointer")) {
@@ -332,6 +405,14 @@ int main(int argc, char** argv) {
     return return_code;
   }
 
+  if (batch_path) {
+    if (inFile) {
+      fprintf(stderr, "error: --batch cannot be used with an input file\n");
+      return 1;
+    }
+    return process_batch(batch_path, jobs, target_env, options);
+  }
+
   if (inFile &&
       std::filesystem::is_directory(std::filesystem::status(inFile))) {
     const std::filesystem::path dir(inFile);